@@ -0,0 +1,33 @@
+#define RKLOG_IMPLEMENTATION
+#include <rklog/rklog.h>
+
+int main(void)
+{
+    // We create our compressed file logger by specifying the file to log to,
+    // the title and the style of the logger
+    RKLogger* logger = rkCreateCompressedFileLogger(
+        "compressed_file_logger_logs.rkz",
+        "compressed_file_logger",
+        RKLOG_DEFAULT_LOG_STYLE
+    );
+
+    // Logging only copies the message into the current block, a background
+    // thread compresses and writes the blocks
+    for (int i = 0; i < 10000; i++)
+        rkLogInfo(logger, "info log %d", i);
+    rkLogWarning(logger, "warning log");
+    rkLogError(logger, "error log");
+    rkLogFatal(logger, "fatal log");
+
+    // Closing the logger writes the last block and stops the thread
+    rkCloseLogger(logger);
+
+    // The file can be read back with `rklogcat`, or right here
+    FILE* in = fopen("compressed_file_logger_logs.rkz", "rb");
+    if (!in) return 1;
+
+    const bool ok = rkDecompressLogFile(in, stdout);
+    fclose(in);
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,54 @@
+#define RKLOG_IMPLEMENTATION
+#include <rklog/rklog.h>
+
+static const char* SOCKET_PATH = "/tmp/rklog_socket_example.sock";
+
+int main(void)
+{
+    // First we play the part of the local agent by listening on a Unix domain
+    // datagram socket. No network is involved
+    const int agent = socket(AF_UNIX, SOCK_DGRAM, 0);
+    if (agent < 0) return 1;
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, SOCKET_PATH, sizeof(addr.sun_path) - 1);
+
+    unlink(SOCKET_PATH);
+    if (bind(agent, (const struct sockaddr*)&addr, sizeof(addr)) != 0)
+        return 1;
+
+    // Then we create our socket logger by specifying the socket to send to,
+    // the kind of socket, the title of the logger and its style
+    RKLogger* logger = rkCreateSocketLogger(SOCKET_PATH, RKLOG_SOCKET_DATAGRAM,
+                                            "socket_logger",
+                                            RKLOG_DEFAULT_LOG_STYLE);
+
+    // Info and warning messages are batched, error and fatal messages are
+    // sent right away together with whatever was batched before them
+    rkLogInfo(logger, "info log");
+    rkLogWarning(logger, "warning log");
+    rkLogError(logger, "error log");
+    rkLogFatal(logger, "fatal log");
+
+    // Flushing hands any remaining batch over to the agent without blocking
+    rkFlushLogger(logger);
+
+    char batch[RKLOG_SOCKET_BATCH_SIZE+1] = {0};
+    ssize_t length = 0;
+    while ((length = recv(agent, batch, RKLOG_SOCKET_BATCH_SIZE,
+                          MSG_DONTWAIT)) > 0)
+    {
+        batch[length] = '\0';
+        printf("agent received %zd bytes:\n%s", length, batch);
+    }
+
+    // Messages only get dropped if the agent cannot keep up
+    printf("dropped messages: %zu\n", rkGetDroppedMessages(logger));
+
+    // And finally close the logger and the agent
+    rkCloseLogger(logger);
+    close(agent);
+    unlink(SOCKET_PATH);
+}
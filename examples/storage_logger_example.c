@@ -0,0 +1,40 @@
+#define RKLOG_IMPLEMENTATION
+#include <rklog/rklog.h>
+
+// Storage for a logger that lives for the whole program, no heap needed
+static RKLoggerStorage mainLoggerStorage;
+
+int main(void)
+{
+    // We can place a logger in storage we own by passing the storage and its
+    // size. RKLoggerStorage has the published size and alignment, but any
+    // arena memory of RKLOG_LOGGER_STORAGE_SIZE bytes aligned to
+    // RKLOG_LOGGER_STORAGE_ALIGN works just as well
+    RKLogger* logger = rkInitLogger(&mainLoggerStorage,
+                                    sizeof(mainLoggerStorage), "storage",
+                                    RKLOG_DEFAULT_LOG_STYLE);
+    rkLogInfo(logger, "this logger lives in static storage");
+
+    // For short-lived loggers, e.g. one per connection, we can create a pool
+    // once up front. Console and file loggers need no buffers, socket and
+    // uring file loggers need the pool to allocate theirs here as well...
+    RKLoggerPool* pool = rkCreateLoggerPool(4, 0);
+
+    // ...and then create and close loggers without any heap traffic. Closed
+    // loggers go back to the pool, buffers and all
+    for (int connection = 0; connection < 8; connection++)
+    {
+        char title[32] = {0};
+        snprintf(title, sizeof(title), "connection%d", connection);
+
+        RKLogger* connectionLogger = rkPoolLogger(pool, title,
+                                                  RKLOG_DEFAULT_LOG_STYLE);
+        rkLogInfo(connectionLogger, "connection opened");
+        rkLogWarning(connectionLogger, "connection closed");
+        rkCloseLogger(connectionLogger);
+    }
+
+    // Closing a logger in our own storage leaves the storage to us
+    rkDestroyLoggerPool(pool);
+    rkCloseLogger(logger);
+}
@@ -0,0 +1,102 @@
+#define RKLOG_IMPLEMENTATION
+#include <rklog/rklog.h>
+
+#define THREAD_COUNT (4)
+#define MESSAGE_COUNT (200000)
+
+/**
+ * @brief Logs `MESSAGE_COUNT` messages with the logger passed to the thread
+ *
+ * @param[in] logger
+ *      A pointer to the handle of the shared logger
+ *
+ * @return
+ *      Always `NULL`
+ */
+static void* logMessages(void* logger)
+{
+    for (int i = 0; i < MESSAGE_COUNT; i++)
+        rkLogInfo((RKLogger*)logger, "thread message %d", i);
+    return NULL;
+}
+
+/**
+ * @brief Logs from `THREAD_COUNT` threads at once with `logger` and closes it
+ *
+ * @param[in] logger
+ *      A pointer to the handle of the shared logger
+ */
+static void logFromThreads(RKLogger* logger)
+{
+    pthread_t threads[THREAD_COUNT];
+    for (int i = 0; i < THREAD_COUNT; i++)
+        pthread_create(&threads[i], NULL, logMessages, logger);
+    for (int i = 0; i < THREAD_COUNT; i++)
+        pthread_join(threads[i], NULL);
+    rkCloseLogger(logger);
+}
+
+/**
+ * @brief Checks that `path` ended up with every message on a line of its own
+ *
+ * @param[in] path
+ *      The path of the log file to check
+ *
+ * @return
+ *      `true` if no message was lost or torn, `false` otherwise
+ */
+static bool checkLines(const char* path)
+{
+    FILE* file = fopen(path, "r");
+    if (!file) return false;
+
+    char line[256];
+    long lines = 0, torn = 0;
+    while (fgets(line, sizeof(line), file))
+    {
+        lines++;
+        if (!strstr(line, "]: thread message "))
+            torn++;
+    }
+    fclose(file);
+
+    printf("%s: %ld of %d lines, %ld torn\n", path, lines,
+           THREAD_COUNT * MESSAGE_COUNT, torn);
+    return lines == THREAD_COUNT * MESSAGE_COUNT && torn == 0;
+}
+
+int main(void)
+{
+    // Loggers can be shared between threads; each message is written whole
+    RKLogger* fileLogger = rkDefaultFileLogger("threaded_file_logs.txt",
+                                               "threaded");
+    if (!fileLogger) return 1;
+    logFromThreads(fileLogger);
+    bool ok = checkLines("threaded_file_logs.txt");
+
+    RKLogger* uringLogger = rkCreateUringFileLogger("threaded_uring_logs.txt",
+                                                    "threaded",
+                                                    RKLOG_DEFAULT_LOG_STYLE);
+    if (!uringLogger) return 1;
+    logFromThreads(uringLogger);
+    ok = checkLines("threaded_uring_logs.txt") && ok;
+
+    // Compressed files are checked once decompressed
+    RKLogger* compressedLogger = rkCreateCompressedFileLogger(
+        "threaded_compressed_logs.rkz",
+        "threaded",
+        RKLOG_DEFAULT_LOG_STYLE
+    );
+    if (!compressedLogger) return 1;
+    logFromThreads(compressedLogger);
+
+    FILE* in = fopen("threaded_compressed_logs.rkz", "rb");
+    FILE* out = fopen("threaded_compressed_logs.txt", "wb");
+    if (!in || !out) return 1;
+    ok = rkDecompressLogFile(in, out) && ok;
+    fclose(in);
+    fclose(out);
+    ok = checkLines("threaded_compressed_logs.txt") && ok;
+
+    return ok ? 0 : 1;
+}
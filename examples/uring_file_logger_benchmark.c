@@ -0,0 +1,49 @@
+#define RKLOG_IMPLEMENTATION
+#include <rklog/rklog.h>
+
+#define MESSAGE_COUNT (1000000)
+
+/**
+ * @brief Logs `MESSAGE_COUNT` messages with `logger` and closes it
+ *
+ * @param[in] logger
+ *      A pointer to the handle of the logger to benchmark
+ *
+ * @return
+ *      The number of seconds it took, including closing the logger
+ */
+static double benchmark(RKLogger* logger)
+{
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (int i = 0; i < MESSAGE_COUNT; i++)
+        rkLogInfo(logger, "benchmark message %d of %d", i, MESSAGE_COUNT);
+    rkCloseLogger(logger);
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (double)(end.tv_sec - start.tv_sec) +
+        (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+int main(void)
+{
+    // First we time the plain `fprintf` based file logger...
+    RKLogger* fileLogger = rkDefaultFileLogger("benchmark_file_logs.txt",
+                                               "benchmark");
+    if (!fileLogger) return 1;
+    const double fileSeconds = benchmark(fileLogger);
+
+    // ...and then the pooled buffer logger, which uses io_uring if it can
+    RKLogger* uringLogger = rkCreateUringFileLogger("benchmark_uring_logs.txt",
+                                                    "benchmark",
+                                                    RKLOG_DEFAULT_LOG_STYLE);
+    if (!uringLogger) return 1;
+    const double uringSeconds = benchmark(uringLogger);
+
+    printf("%d messages\n", MESSAGE_COUNT);
+    printf("file logger:       %.3fs (%.0f messages/s)\n", fileSeconds,
+           MESSAGE_COUNT / fileSeconds);
+    printf("uring file logger: %.3fs (%.0f messages/s)\n", uringSeconds,
+           MESSAGE_COUNT / uringSeconds);
+}
@@ -1,9 +1,26 @@
 #ifndef __RKLOG_H__
 #define __RKLOG_H__
 
+// The POSIX sinks need declarations that strict ISO C modes hide, so request
+// them before the first system header gets included. These only take effect
+// when rklog.h is the first include of the file defining RKLOG_IMPLEMENTATION;
+// otherwise the implementation relies on the few declarations it makes itself.
+// Darwin exposes everything by default and defining `_POSIX_C_SOURCE` there
+// would hide `SO_NOSIGPIPE`, so it is left alone
+#if defined(RKLOG_IMPLEMENTATION) && !defined(_WIN32) &&\
+    !defined(__APPLE__) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+#if defined(RKLOG_IMPLEMENTATION) && defined(__linux__) &&\
+    !defined(_DEFAULT_SOURCE)
+#define _DEFAULT_SOURCE
+#endif
+
 #include <stdarg.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
+#include <stdio.h>
 
 #if defined(__cplusplus)
 extern "C" {
@@ -116,6 +133,60 @@ typedef struct
     RKLogConfig cfgFatalError; /* Configuration for fatal logs */
 } RKLogStyle;
 
+/**
+ * Enum of log-severity flags, combined into masks when querying indexed logs
+ */
+typedef enum
+{
+    RKLOG_SEVERITY_INFO = 1 << 0,    /* Messages logged with `rkLogInfo` */
+    RKLOG_SEVERITY_WARNING = 1 << 1, /* Messages logged with `rkLogWarning` */
+    RKLOG_SEVERITY_ERROR = 1 << 2,   /* Messages logged with `rkLogError` */
+    RKLOG_SEVERITY_FATAL = 1 << 3,   /* Messages logged with `rkLogFatal` */
+} RKLogSeverity;
+
+/* Mask matching every log-severity */
+#define RKLOG_SEVERITY_ALL (0xf)
+
+#if !defined(_WIN32)
+/**
+ * Enum specifying the kind of Unix domain socket a socket logger connects to
+ */
+typedef enum
+{
+    RKLOG_SOCKET_DATAGRAM, /* Connectionless `SOCK_DGRAM` socket */
+    RKLOG_SOCKET_STREAM,   /* Connection-oriented `SOCK_STREAM` socket */
+} RKSocketType;
+#endif
+
+// --- logger storage ---------------------------------------------------------
+
+/* The number of bytes of caller-provided storage a logger needs at most */
+#define RKLOG_LOGGER_STORAGE_SIZE (1024)
+/* The alignment caller-provided storage of a logger needs at least */
+#define RKLOG_LOGGER_STORAGE_ALIGN (8)
+
+/**
+ * Flags specifying which sink buffers a logger pool allocates up front for
+ * each of its loggers
+ */
+typedef enum
+{
+    RKLOG_POOL_SOCKET_BUFFERS = 1 << 0, /* 64 KiB for `rkPoolSocketLogger` */
+    RKLOG_POOL_URING_BUFFERS = 1 << 1,  /* 512 KiB for `rkPoolUringFileLogger` */
+} RKLoggerPoolBuffers;
+
+/**
+ * Union with the size and alignment needed to hold a logger, for declaring
+ * static or stack storage to pass to `rkInitLogger` and `rkInitFileLogger`
+ */
+typedef union
+{
+    unsigned char bytes[RKLOG_LOGGER_STORAGE_SIZE]; /* The raw storage */
+    uint64_t alignInteger;                          /* Forces alignment */
+    double alignFloat;                              /* Forces alignment */
+    void* alignPointer;                             /* Forces alignment */
+} RKLoggerStorage;
+
 // --- logger interface -------------------------------------------------------
 
 /**
@@ -123,6 +194,11 @@ typedef struct
  */
 typedef struct RKLogger RKLogger;
 
+/**
+ * Struct representing a handle to a pool of recyclable loggers
+ */
+typedef struct RKLoggerPool RKLoggerPool;
+
 /**
  * @brief Creates a console logger with default presets
  *
@@ -176,9 +252,378 @@ RKLogger* rkCreateLogger(const char* title, RKLogStyle style);
 RKLogger* rkCreateFileLogger(const char* fileName, const char* title,
                              RKLogStyle style);
 
+#if !defined(_WIN32)
+/**
+ * @brief Creates a logger that ships its log messages to a local agent over a
+ * Unix domain socket. Log messages are batched in a bounded buffer and sent
+ * with non-blocking sends, so a slow agent never stalls the caller. Error and
+ * fatal messages are sent right away, and a partial batch goes out with the
+ * first message logged a second or more after it started. If the agent is not
+ * listening yet, or goes away, the logger reconnects lazily on a later send.
+ * Messages dropped while the buffer is full are counted, see
+ * `rkGetDroppedMessages`
+ *
+ * @param[in] socketPath
+ *      The filesystem path of the socket the agent listens on
+ * @param[in] type
+ *      Whether the agent listens on a datagram or a stream socket
+ * @param[in] title
+ *      The title of the socket logger
+ * @param[in] style
+ *      The custom styling configuration for the socket logger
+ *
+ * @return
+ *      A pointer to the handle of the socket logger, or `NULL` upon failure
+ */
+RKLogger* rkCreateSocketLogger(const char* socketPath, RKSocketType type,
+                               const char* title, RKLogStyle style);
+
+/**
+ * @brief Creates a file logger that collects log messages in a pool of large
+ * buffers and writes whole buffers at a time. On Linux the buffers are
+ * registered with io_uring and each full buffer is submitted right away, so
+ * the caller does not block on a `write` per buffer. Where io_uring is
+ * unavailable, or the kernel stops accepting submissions, the logger falls
+ * back to plain `write` calls on the file descriptor. Log messages wait in
+ * process memory only while their 64 KiB buffer fills, so a crash loses at
+ * most that buffer; call `rkFlushLogger` to bound this for a quiet logger. The
+ * logger may be shared between threads; each message is formatted into the
+ * buffer under the logger's lock
+ *
+ * @param[in] fileName
+ *      The name of the file to log to
+ * @param[in] title
+ *      The title of the file logger
+ * @param[in] style
+ *      The custom styling configuration for the file logger
+ *
+ * @return
+ *      A pointer to the handle of the file logger, or `NULL` upon failure
+ */
+RKLogger* rkCreateUringFileLogger(const char* fileName, const char* title,
+                                  RKLogStyle style);
+
+/**
+ * @brief Creates a file logger that writes its log messages as a sequence of
+ * independently compressed blocks. Log messages are copied into the current
+ * block and a background thread compresses and writes full blocks, as well as
+ * partly filled blocks once they are five seconds old. A crash therefore loses
+ * the log messages of the last five seconds at most, or, when logging faster
+ * than the thread can keep up with, the block being filled plus the three
+ * full 64 KiB blocks that may still be queued for compression: up to 256 KiB.
+ * `rkFlushLogger` waits until every block has been written. The logger may be
+ * shared between threads. Use
+ * `rkDecompressLogFile` (or the `rklogcat` tool) to read the file back
+ *
+ * @param[in] fileName
+ *      The name of the file to log to
+ * @param[in] title
+ *      The title of the file logger
+ * @param[in] style
+ *      The custom styling configuration for the file logger
+ *
+ * @return
+ *      A pointer to the handle of the file logger, or `NULL` upon failure
+ */
+RKLogger* rkCreateCompressedFileLogger(const char* fileName, const char* title,
+                                       RKLogStyle style);
+#endif
+
+/**
+ * @brief Decompresses a file written by a compressed file logger. Blocks are
+ * decoded one at a time, so only a truncated or damaged block (and anything
+ * after it) is lost
+ *
+ * @param[in] in
+ *      The compressed input stream, opened in binary mode
+ * @param[in] out
+ *      The output stream the plain log messages get written to
+ *
+ * @return
+ *      `true` if every block decoded cleanly, `false` otherwise
+ */
+bool rkDecompressLogFile(FILE* in, FILE* out);
+
+/**
+ * @brief Makes a file logger maintain a sidecar index of its log file. The
+ * index records, per block of log messages, where the block lives in the log
+ * file, the time range it covers and which log-severities it contains. Entries
+ * are appended as blocks fill up, so keeping the index costs a few counters
+ * per log message. Each entry also records the writer's UTC offset and where
+ * its local day started, and a block ends whenever either changes, so readers
+ * resolve the `HH:MM:SS` labels the same way in any time zone
+ *
+ * @param[in] logger
+ *      A pointer to the handle of a file, uring file or compressed file logger
+ * @param[in] indexFileName
+ *      The name of the index file to write
+ *
+ * @return
+ *      `true` on success, `false` if the logger does not log to a file or the
+ *      index file could not be created
+ */
+bool rkEnableLogIndex(RKLogger* logger, const char* indexFileName);
+
+#if !defined(_WIN32)
+/**
+ * Struct representing a handle to a reader of indexed log files
+ */
+typedef struct RKLogReader RKLogReader;
+
+/**
+ * Callback receiving the log messages matched by `rkQueryLog`
+ *
+ * @param[in] line
+ *      The log message, from its labeled line through the lines continuing
+ *      it, without its trailing newline
+ * @param[in] length
+ *      The length of the log message in bytes
+ * @param[in] severity
+ *      The log-severity of the log message
+ * @param[in] timestamp
+ *      The time the log message was logged at, in seconds since the epoch
+ * @param[in] userData
+ *      The pointer passed to `rkQueryLog`
+ *
+ * @return
+ *      `true` to continue the query, `false` to stop it
+ */
+typedef bool (*RKLogVisitor)(const char* line, size_t length,
+                             RKLogSeverity severity, int64_t timestamp,
+                             void* userData);
+
+/**
+ * @brief Opens an indexed log file for querying. Both files are memory mapped,
+ * so only the blocks a query selects are ever touched
+ *
+ * @param[in] fileName
+ *      The name of the log file, plain or compressed
+ * @param[in] indexFileName
+ *      The name of the index file written alongside it
+ *
+ * @return
+ *      A pointer to the handle of the log reader, or `NULL` upon failure
+ */
+RKLogReader* rkOpenLogReader(const char* fileName, const char* indexFileName);
+
+/**
+ * @brief Visits the log messages logged within a time range with one of the
+ * given log-severities. A log message spanning several lines is visited once,
+ * as a whole. Blocks that cannot match are skipped using the index
+ *
+ * @param[in] reader
+ *      A pointer to the handle of the log reader
+ * @param[in] from
+ *      The start of the time range, in seconds since the epoch
+ * @param[in] to
+ *      The inclusive end of the time range, in seconds since the epoch
+ * @param[in] severities
+ *      A mask of `RKLogSeverity` flags to match
+ * @param[in] visitor
+ *      The callback receiving each matching log message
+ * @param[in] userData
+ *      A pointer passed on to `visitor`
+ *
+ * @return
+ *      The number of log messages passed to `visitor`
+ */
+size_t rkQueryLog(RKLogReader* reader, int64_t from, int64_t to,
+                  uint32_t severities, RKLogVisitor visitor, void* userData);
+
+/**
+ * @brief Unmaps the files of the log reader and releases it
+ *
+ * @param[in] reader
+ *      A pointer to the handle of the log reader
+ */
+void rkCloseLogReader(RKLogReader* reader);
+#endif
+
+/**
+ * @brief Creates a console logger in caller-provided storage, without any heap
+ * allocation. Closing the logger with `rkCloseLogger` leaves the storage to
+ * the caller
+ *
+ * @param[in] storage
+ *      The storage to place the logger in, aligned to at least
+ *      `RKLOG_LOGGER_STORAGE_ALIGN`, e.g. an `RKLoggerStorage`
+ * @param[in] size
+ *      The size of `storage` in bytes, at least `RKLOG_LOGGER_STORAGE_SIZE`
+ * @param[in] title
+ *      The title of the console logger
+ * @param[in] style
+ *      The custom styling configuration for the console logger
+ *
+ * @return
+ *      A pointer to the handle of the console logger, or `NULL` if `storage`
+ *      is too small or misaligned
+ */
+RKLogger* rkInitLogger(void* storage, size_t size, const char* title,
+                       RKLogStyle style);
+
+/**
+ * @brief Creates a file logger in caller-provided storage. The logger itself
+ * needs no heap allocation, although the C library may allocate for the
+ * `FILE*` it opens. Closing the logger with `rkCloseLogger` leaves the storage
+ * to the caller
+ *
+ * @param[in] storage
+ *      The storage to place the logger in, aligned to at least
+ *      `RKLOG_LOGGER_STORAGE_ALIGN`, e.g. an `RKLoggerStorage`
+ * @param[in] size
+ *      The size of `storage` in bytes, at least `RKLOG_LOGGER_STORAGE_SIZE`
+ * @param[in] fileName
+ *      The name of the file to log to
+ * @param[in] title
+ *      The title of the file logger
+ * @param[in] style
+ *      The custom styling configuration for the file logger
+ *
+ * @return
+ *      A pointer to the handle of the file logger, or `NULL` upon failure
+ */
+RKLogger* rkInitFileLogger(void* storage, size_t size, const char* fileName,
+                           const char* title, RKLogStyle style);
+
+/**
+ * @brief Creates a pool of `capacity` loggers. The loggers and the sink
+ * buffers selected by `buffers` are allocated here, once for every logger of
+ * the pool, so that pooled loggers never allocate on the heap themselves.
+ * Closing a pooled logger hands it back to the pool with its buffers. A pool
+ * is not thread-safe
+ *
+ * @param[in] capacity
+ *      The maximum number of pooled loggers open at the same time
+ * @param[in] buffers
+ *      A mask of `RKLoggerPoolBuffers` flags for the sinks the pool serves,
+ *      or `0` for console and file loggers only
+ *
+ * @return
+ *      A pointer to the handle of the pool, or `NULL` upon failure
+ */
+RKLoggerPool* rkCreateLoggerPool(size_t capacity, uint32_t buffers);
+
+/**
+ * @brief Releases a pool and the buffers it kept. Every logger taken from the
+ * pool must have been closed before
+ *
+ * @param[in] pool
+ *      A pointer to the handle of the pool
+ */
+void rkDestroyLoggerPool(RKLoggerPool* pool);
+
+/**
+ * @brief Creates a console logger from a pool
+ *
+ * @param[in] pool
+ *      A pointer to the handle of the pool
+ * @param[in] title
+ *      The title of the console logger
+ * @param[in] style
+ *      The custom styling configuration for the console logger
+ *
+ * @return
+ *      A pointer to the handle of the console logger, or `NULL` if the pool
+ *      is exhausted
+ */
+RKLogger* rkPoolLogger(RKLoggerPool* pool, const char* title,
+                       RKLogStyle style);
+
+/**
+ * @brief Creates a file logger from a pool. The logger itself needs no heap
+ * allocation, although the C library may allocate for the `FILE*` it opens
+ *
+ * @param[in] pool
+ *      A pointer to the handle of the pool
+ * @param[in] fileName
+ *      The name of the file to log to
+ * @param[in] title
+ *      The title of the file logger
+ * @param[in] style
+ *      The custom styling configuration for the file logger
+ *
+ * @return
+ *      A pointer to the handle of the file logger, or `NULL` upon failure
+ */
+RKLogger* rkPoolFileLogger(RKLoggerPool* pool, const char* fileName,
+                           const char* title, RKLogStyle style);
+
+#if !defined(_WIN32)
+/**
+ * @brief Creates a socket logger from a pool, using the message buffer the
+ * pool allocated for it. See `rkCreateSocketLogger`
+ *
+ * @param[in] pool
+ *      A pointer to the handle of the pool
+ * @param[in] socketPath
+ *      The filesystem path of the socket the agent listens on
+ * @param[in] type
+ *      Whether the agent listens on a datagram or a stream socket
+ * @param[in] title
+ *      The title of the socket logger
+ * @param[in] style
+ *      The custom styling configuration for the socket logger
+ *
+ * @return
+ *      A pointer to the handle of the socket logger, or `NULL` upon failure,
+ *      including when the pool lacks `RKLOG_POOL_SOCKET_BUFFERS`
+ */
+RKLogger* rkPoolSocketLogger(RKLoggerPool* pool, const char* socketPath,
+                             RKSocketType type, const char* title,
+                             RKLogStyle style);
+
+/**
+ * @brief Creates a uring file logger from a pool, using the buffers the pool
+ * allocated for it. See `rkCreateUringFileLogger`
+ *
+ * @param[in] pool
+ *      A pointer to the handle of the pool
+ * @param[in] fileName
+ *      The name of the file to log to
+ * @param[in] title
+ *      The title of the file logger
+ * @param[in] style
+ *      The custom styling configuration for the file logger
+ *
+ * @return
+ *      A pointer to the handle of the file logger, or `NULL` upon failure,
+ *      including when the pool lacks `RKLOG_POOL_URING_BUFFERS`
+ */
+RKLogger* rkPoolUringFileLogger(RKLoggerPool* pool, const char* fileName,
+                                const char* title, RKLogStyle style);
+#endif
+
+#if !defined(_WIN32)
+/**
+ * @brief Gets the number of log messages a socket logger dropped because its
+ * bounded buffer was full while the agent was slow or unreachable
+ *
+ * @param[in] logger
+ *      A pointer to the handle of the logger
+ *
+ * @return
+ *      The number of dropped log messages, always `0` for other loggers
+ */
+size_t rkGetDroppedMessages(RKLogger* logger);
+#endif
+
+/**
+ * @brief Pushes out any log messages the logger is still holding on to. For
+ * socket loggers this is a best-effort, non-blocking attempt; messages the
+ * agent cannot take yet stay buffered
+ *
+ * @param[in] logger
+ *      A pointer to the handle of the logger
+ */
+void rkFlushLogger(RKLogger* logger);
+
 /**
  * @brief Frees all resources used by the logger. If `logger` is a file logger,
- * this will close the file before releasing the memory used by `logger`
+ * this will close the file before releasing the memory used by `logger`.
+ * Loggers in caller-provided storage leave the storage to the caller, and
+ * pooled loggers go back to their pool. A socket logger makes one last
+ * non-blocking attempt to send its queued log messages; whatever the agent
+ * does not take then is discarded
  *
  * @param[in] logger
  *      A pointer to the handle of the logger to close
@@ -300,6 +745,34 @@ void rkLogFatalArgs(RKLogger* logger, const char* fmt, va_list args);
 #if defined(RKLOG_PLATFORM_WINDOWS)
 #define WINDOWS_LEAN_AND_MEAN
 #include <Windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#if defined(RKLOG_PLATFORM_LINUX) && !defined(RKLOG_NO_IO_URING) &&\
+    defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define RKLOG_HAS_IO_URING
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+
+// `syscall` is hidden in strict ISO C modes unless rklog.h came first
+long syscall(long number, ...);
+
+#if defined(MAP_POPULATE)
+#define RKLOG_MAP_POPULATE MAP_POPULATE
+#else
+#define RKLOG_MAP_POPULATE 0
+#endif
+#endif
 #endif
 
 // --- string tokens ----------------------------------------------------------
@@ -335,14 +808,157 @@ void rkLogFatalArgs(RKLogger* logger, const char* fmt, va_list args);
 
 // --- constants --------------------------------------------------------------
 
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+/* The maximum number of bytes handed to a single socket send */
+#define RKLOG_SOCKET_BATCH_SIZE (4096)
+/* The maximum number of bytes a socket logger holds while the agent is slow */
+#define RKLOG_SOCKET_BUFFER_SIZE (64 * 1024)
+/* The number of seconds after which a partial batch is sent with the next log */
+#define RKLOG_SOCKET_MAX_DELAY (1)
+
+/* The number of buffers in the pool of a uring file logger */
+#define RKLOG_URING_BUFFER_COUNT (8)
+/* The size of each buffer in the pool of a uring file logger */
+#define RKLOG_URING_BUFFER_SIZE (64 * 1024)
+
+/* The number of raw blocks a compressed file logger cycles through */
+#define RKLOG_COMPRESS_BLOCK_COUNT (4)
+/* The number of seconds after which a partly filled block gets compressed */
+#define RKLOG_COMPRESS_MAX_DELAY (5)
+#endif
+
+/* The uncompressed size of each block of a compressed log file */
+#define RKLOG_COMPRESS_BLOCK_SIZE (64 * 1024)
+/* The size of the header preceding each block of a compressed log file */
+#define RKLOG_COMPRESS_HEADER_SIZE (16)
+/* The magic bytes every block of a compressed log file starts with */
+#define RKLOG_COMPRESS_MAGIC "RKZ1"
+/* The number of entries in the match finder of the block compressor */
+#define RKLOG_COMPRESS_HASH_SIZE (4096)
+/* The shortest match the block compressor encodes */
+#define RKLOG_COMPRESS_MIN_MATCH (4)
+/* An upper bound on the compressed size of a block of `N` bytes */
+#define RKLOG_COMPRESS_BOUND(N) ((N) + (N) / 255 + 16)
+
+/* The number of log file bytes after which an index entry gets written */
+#define RKLOG_INDEX_BLOCK_SIZE (64 * 1024)
+/* The magic bytes an index file starts with */
+#define RKLOG_INDEX_MAGIC "RKIX"
+/* The size of the header of an index file */
+#define RKLOG_INDEX_HEADER_SIZE (256)
+/* The version of the index file format */
+#define RKLOG_INDEX_VERSION (2)
+/* The size of each entry of an index file */
+#define RKLOG_INDEX_ENTRY_SIZE (56)
+/* The space reserved for each tag in the header of an index file */
+#define RKLOG_INDEX_TAG_SIZE (40)
+
+/**
+ * Enum specifying where a logger sends its log messages
+ */
+typedef enum
+{
+    RKLOG_SINK_CONSOLE, /* Colored output to `stderr` */
+    RKLOG_SINK_FILE,    /* Plain output to a `FILE*` */
+    RKLOG_SINK_SOCKET,  /* Batched output to a Unix domain socket */
+    RKLOG_SINK_URING,   /* Pooled buffer output to a file descriptor */
+    RKLOG_SINK_COMPRESSED, /* Block compressed output to a file descriptor */
+} RKSinkType;
+
+/**
+ * Struct describing one block of log messages in an index file
+ */
+typedef struct
+{
+    uint64_t offset;     /* The offset of the block in the log file */
+    uint64_t length;     /* The size of the block in the log file */
+    int64_t firstTime;   /* The time of the first log message of the block */
+    int64_t lastTime;    /* The time of the last log message of the block */
+    uint32_t severities; /* The `RKLogSeverity` flags of its log messages */
+    uint32_t messages;   /* The number of log messages in the block */
+    int64_t dayStart;    /* The time its labels read 00:00:00 at */
+    int32_t utcOffset;   /* The UTC offset of the writer, in seconds */
+} RKIndexEntry;
+
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+/**
+ * Struct containing the state shared between a compressed file logger and its
+ * background compression thread. Full blocks form a queue starting at `head`;
+ * the loggers fill `fillIndex`, which is never part of that queue. Threads
+ * reserve their bytes in the fill block under `mutex` and copy them in after
+ * releasing it, so the compression thread waits for `writers` of the oldest
+ * queued block to drop to zero
+ */
+typedef struct
+{
+    pthread_t thread;      /* The background compression thread */
+    pthread_mutex_t mutex; /* Guards everything but the block contents */
+    pthread_cond_t queued; /* Signalled when a block is queued or on stop */
+    pthread_cond_t done;   /* Signalled when a queued block has been written */
+    int fd;                /* The file descriptor of the compressed file */
+    char* blocks;          /* `RKLOG_COMPRESS_BLOCK_COUNT` raw blocks */
+    size_t lengths[RKLOG_COMPRESS_BLOCK_COUNT]; /* Bytes reserved per block */
+    size_t writers[RKLOG_COMPRESS_BLOCK_COUNT]; /* Copies pending per block */
+    size_t head;           /* The index of the oldest queued block */
+    size_t count;          /* The number of queued blocks */
+    size_t fillIndex;      /* The index of the block being filled */
+    bool fillReady;        /* `false` while waiting for a free fill block */
+    bool stop;             /* Tells the compression thread to finish up */
+    char* scratch;         /* Output buffer of the compression thread */
+    uint64_t fileOffset;   /* The size of the compressed file so far */
+    FILE* index;           /* The index file, guarded by `mutex`, or `NULL` */
+    RKIndexEntry stats[RKLOG_COMPRESS_BLOCK_COUNT]; /* Index entry per block */
+} RKCompressor;
+#endif
+
+/**
+ * Enum specifying where the memory of a logger comes from
+ */
+typedef enum
+{
+    RKLOG_ORIGIN_HEAP,   /* Allocated with `malloc` */
+    RKLOG_ORIGIN_CALLER, /* Caller-provided storage */
+    RKLOG_ORIGIN_POOL,   /* A slot of an `RKLoggerPool` */
+} RKLoggerOrigin;
+
+#if defined(RKLOG_HAS_IO_URING)
+/**
+ * Struct containing the mapped submission and completion queues of an
+ * io_uring instance
+ */
+typedef struct
+{
+    int fd;                    /* The ring file descriptor, or `-1` */
+    unsigned* sqHead;          /* Head of the submission queue */
+    unsigned* sqTail;          /* Tail of the submission queue */
+    unsigned* sqMask;          /* Index mask of the submission queue */
+    unsigned* sqArray;         /* Indirection array into `sqes` */
+    struct io_uring_sqe* sqes; /* The submission queue entries */
+    unsigned* cqHead;          /* Head of the completion queue */
+    unsigned* cqTail;          /* Tail of the completion queue */
+    unsigned* cqMask;          /* Index mask of the completion queue */
+    struct io_uring_cqe* cqes; /* The completion queue entries */
+    void* sqRing;              /* The mapping of the submission queue */
+    size_t sqRingSize;         /* The size of `sqRing` in bytes */
+    void* cqRing;              /* The mapping of the completion queue */
+    size_t cqRingSize;         /* The size of `cqRing` in bytes */
+    size_t sqesSize;           /* The size of `sqes` in bytes */
+    unsigned toSubmit;         /* Queued entries not yet handed to the kernel */
+    unsigned inFlight;         /* Writes the kernel has not completed yet */
+} RKUring;
+#endif
+
 /**
  * Struct representing a specific point in time for when the log occured
  */
 typedef struct
 {
-    uint32_t hours;   /* The system hours */
-    uint32_t minutes; /* The system minutes */
-    uint32_t seconds; /* The system seconds */
+    int64_t time;      /* The point in time, in seconds since the epoch */
+    int64_t dayStart;  /* `time` minus the local time of day */
+    int32_t utcOffset; /* The offset of the local time from UTC, in seconds */
+    uint32_t hours;    /* The system hours */
+    uint32_t minutes;  /* The system minutes */
+    uint32_t seconds;  /* The system seconds */
 } RKTimeStamp;
 
 /**
@@ -355,29 +971,130 @@ struct RKLogger
     char title[RKLOG_MAX_LOGGER_TITLE_SIZE+1];
     /* The styling of the log messages of the logger */
     RKLogStyle style;
+    /* Where the memory of the logger comes from */
+    RKLoggerOrigin origin;
+    /* The pool the logger belongs to, if `origin` is `RKLOG_ORIGIN_POOL` */
+    RKLoggerPool* pool;
+    /* The kind of output the logger logs to */
+    RKSinkType sink;
     /* The output stream where log messages gets logged to */
     FILE* output;
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+    /* The socket connected to the agent, or `-1` when disconnected */
+    int socketFd;
+    /* The kind of socket the agent listens on */
+    RKSocketType socketType;
+    /* The path of the socket the agent listens on */
+    char socketPath[sizeof(((struct sockaddr_un*)0)->sun_path)];
+    /* Log messages that have not been sent to the agent yet */
+    char* pending;
+    /* The number of bytes in use in `pending` */
+    size_t pendingLength;
+    /* The time the oldest log message in `pending` was queued at */
+    time_t pendingSince;
+    /* The time the last connection attempt failed at, or `0` */
+    time_t connectFailedAt;
+    /* Flag indicating whether a stream send stopped within a log message */
+    bool partialRecord;
+    /* The number of log messages dropped because `pending` was full */
+    size_t droppedMessages;
+    /* The file descriptor uring file loggers write to */
+    int fileFd;
+    /* The offset in the file at which the next buffer gets written */
+    uint64_t fileOffset;
+    /* The pool of `RKLOG_URING_BUFFER_COUNT` buffers, stored back to back */
+    char* buffers;
+    /* The number of bytes each buffer carries to the file */
+    size_t bufferLengths[RKLOG_URING_BUFFER_COUNT];
+    /* The file offset each buffer is written at */
+    uint64_t bufferOffsets[RKLOG_URING_BUFFER_COUNT];
+    /* Stack of buffer indices that are free to be filled */
+    uint32_t freeBuffers[RKLOG_URING_BUFFER_COUNT];
+    /* The number of entries in `freeBuffers` */
+    size_t freeCount;
+    /* The index of the buffer being filled, or `-1` if there is none */
+    int32_t fillBuffer;
+#if defined(RKLOG_HAS_IO_URING)
+    /* The io_uring instance, with `ring.fd == -1` when unavailable */
+    RKUring ring;
+#endif
+    /* The compression state of compressed file loggers */
+    RKCompressor* compressor;
+#endif
+    /* The index file of the logger, or `NULL` when not indexing */
+    FILE* index;
+    /* The block of the log file the next index entry describes */
+    RKIndexEntry indexBlock;
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+    /* Serializes file, socket and uring loggers between threads */
+    pthread_mutex_t lock;
+#endif
 };
 
 /**
- * @brief Allocates a new instance of a logger
+ * Struct definition for a pool of loggers
+ */
+struct RKLoggerPool
+{
+    /* The number of loggers in the pool */
+    size_t capacity;
+    /* The loggers of the pool, keeping their buffers while closed */
+    RKLogger* loggers;
+    /* The `RKLoggerPoolBuffers` flags the pool was created with */
+    uint32_t buffers;
+    /* The message buffers of the socket loggers, stored back to back */
+    char* socketBuffers;
+    /* The buffer pools of the uring file loggers, stored back to back */
+    char* uringBuffers;
+    /* Stack of the loggers that are not in use */
+    RKLogger** freeLoggers;
+    /* The number of entries in `freeLoggers` */
+    size_t freeCount;
+};
+
+/**
+ * Struct used to measure the alignment of a logger
+ */
+typedef struct
+{
+    char padding;    /* Pushes `logger` to its alignment */
+    RKLogger logger; /* The logger to measure */
+} RKLoggerAlignment;
+
+/* The alignment of a logger */
+#define RKLOG_LOGGER_ALIGNMENT offsetof(RKLoggerAlignment, logger)
+
+/* Compile-time check that loggers fit in the published storage */
+typedef char RKLoggerStorageSizeCheck[
+    sizeof(RKLogger) <= RKLOG_LOGGER_STORAGE_SIZE ? 1 : -1
+];
+/* Compile-time check that loggers fit the published alignment */
+typedef char RKLoggerStorageAlignCheck[
+    RKLOG_LOGGER_ALIGNMENT <= RKLOG_LOGGER_STORAGE_ALIGN ? 1 : -1
+];
+
+/**
+ * @brief Initializes the sink independent state of a logger. The buffers a
+ * pooled logger got from its pool are left alone
  *
+ * @param[in] logger
+ *      A pointer to the logger to initialize
+ * @param[in] sink
+ *      The kind of output the logger logs to
  * @param[in] out
- *      The output stream the logger should log to
+ *      The output stream the logger should log to, or `NULL` for loggers that
+ *      do not log to a `FILE*`
  * @param[in] title
  *      The title of the logger
  * @param[in] style
  *      The styling configuration for the log messages
  *
  * @return
- *      A pointer to the newly allocated logger, or `NULL` upon failure. This
- *      can fail if `malloc` failed
+ *      `true` on success, `false` otherwise
  */
-static RKLogger* rkNewLogger(FILE* out, const char* title, RKLogStyle style)
+static bool rkPrepareLogger(RKLogger* logger, RKSinkType sink, FILE* out,
+                            const char* title, RKLogStyle style)
 {
-    RKLogger* const logger = (RKLogger*)malloc(sizeof(RKLogger));
-    if (!logger) return NULL;
-
 #if defined(RKLOG_PLATFORM_WINDOWS)
     const errno_t err = strcpy_s(
         logger->title,
@@ -385,15 +1102,34 @@ static RKLogger* rkNewLogger(FILE* out, const char* title, RKLogStyle style)
         title
     );
     if (err != 0)
-    {
-        free(logger);
-        return NULL;
-    }
+        return false;
 #else
     strncpy(logger->title, title, RKLOG_MAX_LOGGER_TITLE_SIZE);
+    logger->title[RKLOG_MAX_LOGGER_TITLE_SIZE] = '\0';
 #endif
     logger->style = style;
+    logger->sink = sink;
     logger->output = out;
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+    logger->socketFd = -1;
+    logger->socketType = RKLOG_SOCKET_DATAGRAM;
+    logger->socketPath[0] = '\0';
+    logger->pendingLength = 0;
+    logger->pendingSince = 0;
+    logger->connectFailedAt = 0;
+    logger->partialRecord = false;
+    logger->droppedMessages = 0;
+    logger->fileFd = -1;
+    logger->fileOffset = 0;
+    logger->freeCount = 0;
+    logger->fillBuffer = -1;
+#if defined(RKLOG_HAS_IO_URING)
+    logger->ring.fd = -1;
+#endif
+    logger->compressor = NULL;
+#endif
+    logger->index = NULL;
+    memset(&logger->indexBlock, 0, sizeof(logger->indexBlock));
 
 #if defined(RKLOG_PLATFORM_WINDOWS)
     if (out == stderr)
@@ -406,6 +1142,226 @@ static RKLogger* rkNewLogger(FILE* out, const char* title, RKLogStyle style)
     }
 #endif
 
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+    if (pthread_mutex_init(&logger->lock, NULL) != 0)
+        return false;
+#endif
+
+    return true;
+}
+
+/**
+ * @brief Locks a logger for the calling thread. Console loggers rely on the
+ * locking `stdio` does per call, and on Windows the lock is a no-op
+ *
+ * @param[in] logger
+ *      A pointer to the logger to lock
+ */
+static void rkLockLogger(RKLogger* logger)
+{
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+    pthread_mutex_lock(&logger->lock);
+#else
+    (void)logger;
+#endif
+}
+
+/**
+ * @brief Unlocks a logger locked with `rkLockLogger`
+ *
+ * @param[in] logger
+ *      A pointer to the logger to unlock
+ */
+static void rkUnlockLogger(RKLogger* logger)
+{
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+    pthread_mutex_unlock(&logger->lock);
+#else
+    (void)logger;
+#endif
+}
+
+/**
+ * @brief Takes a logger from its memory origin without initializing it
+ *
+ * @param[in] origin
+ *      Where the memory of the logger comes from
+ * @param[in] source
+ *      The caller-provided storage or the `RKLoggerPool`, depending on
+ *      `origin`; ignored for `RKLOG_ORIGIN_HEAP`
+ * @param[in] size
+ *      The size of the caller-provided storage in bytes
+ *
+ * @return
+ *      A pointer to the logger, or `NULL` if `malloc` failed, the storage is
+ *      unsuitable or the pool is exhausted
+ */
+static RKLogger* rkAcquireLogger(RKLoggerOrigin origin, void* source,
+                                 size_t size)
+{
+    RKLogger* logger = NULL;
+    switch (origin)
+    {
+        case RKLOG_ORIGIN_HEAP:
+        {
+            logger = (RKLogger*)malloc(sizeof(RKLogger));
+            if (!logger) return NULL;
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+            logger->pending = NULL;
+            logger->buffers = NULL;
+#endif
+        } break;
+        case RKLOG_ORIGIN_CALLER:
+        {
+            if (!source || size < sizeof(RKLogger) ||
+                (uintptr_t)source % RKLOG_LOGGER_ALIGNMENT != 0)
+                return NULL;
+
+            logger = (RKLogger*)source;
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+            logger->pending = NULL;
+            logger->buffers = NULL;
+#endif
+        } break;
+        case RKLOG_ORIGIN_POOL:
+        {
+            RKLoggerPool* const pool = (RKLoggerPool*)source;
+            if (pool->freeCount == 0)
+                return NULL;
+
+            logger = pool->freeLoggers[--pool->freeCount];
+        } break;
+    }
+
+    logger->origin = origin;
+    logger->pool = origin == RKLOG_ORIGIN_POOL ? (RKLoggerPool*)source : NULL;
+    return logger;
+}
+
+/**
+ * @brief Gives the memory of a logger back to where it came from. Heap
+ * loggers are freed along with their buffers, pooled loggers return to their
+ * pool with their buffers kept for the next use
+ *
+ * @param[in] logger
+ *      A pointer to the logger, whose sink has been closed already
+ */
+static void rkRecycleLogger(RKLogger* logger)
+{
+    switch (logger->origin)
+    {
+        case RKLOG_ORIGIN_HEAP:
+        {
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+            free(logger->pending);
+            free(logger->buffers);
+#endif
+            free(logger);
+        } break;
+        case RKLOG_ORIGIN_CALLER:
+            break;
+        case RKLOG_ORIGIN_POOL:
+        {
+            RKLoggerPool* const pool = logger->pool;
+            pool->freeLoggers[pool->freeCount++] = logger;
+        } break;
+    }
+}
+
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+/**
+ * @brief Allocates a new instance of a logger
+ *
+ * @param[in] sink
+ *      The kind of output the logger logs to
+ * @param[in] out
+ *      The output stream the logger should log to, or `NULL` for loggers that
+ *      do not log to a `FILE*`
+ * @param[in] title
+ *      The title of the logger
+ * @param[in] style
+ *      The styling configuration for the log messages
+ *
+ * @return
+ *      A pointer to the newly allocated logger, or `NULL` upon failure. This
+ *      can fail if `malloc` failed
+ */
+static RKLogger* rkNewLogger(RKSinkType sink, FILE* out, const char* title,
+                             RKLogStyle style)
+{
+    RKLogger* const logger = rkAcquireLogger(RKLOG_ORIGIN_HEAP, NULL, 0);
+    if (!logger) return NULL;
+
+    if (!rkPrepareLogger(logger, sink, out, title, style))
+    {
+        rkRecycleLogger(logger);
+        return NULL;
+    }
+
+    return logger;
+}
+#endif
+
+/**
+ * @brief Opens a file for a file logger to write to
+ *
+ * @param[in] fileName
+ *      The name of the file to open
+ *
+ * @return
+ *      The opened file, or `NULL` upon failure
+ */
+static FILE* rkOpenLogFile(const char* fileName)
+{
+#if defined(RKLOG_PLATFORM_WINDOWS)
+    // Binary mode keeps newlines as written, so the lengths `fprintf` returns
+    // are the offsets the log index records
+    FILE* out = NULL;
+    if (fopen_s(&out, fileName, "wb") != 0)
+        return NULL;
+#else
+    FILE* out = fopen(fileName, "w");
+#endif
+
+    return out;
+}
+
+/**
+ * @brief Creates a console or file logger in memory of the given origin
+ *
+ * @param[in] origin
+ *      Where the memory of the logger comes from
+ * @param[in] source
+ *      The caller-provided storage or the `RKLoggerPool`, see
+ *      `rkAcquireLogger`
+ * @param[in] size
+ *      The size of the caller-provided storage in bytes
+ * @param[in] fileName
+ *      The name of the file to log to, or `NULL` for a console logger
+ * @param[in] title
+ *      The title of the logger
+ * @param[in] style
+ *      The styling configuration for the log messages
+ *
+ * @return
+ *      A pointer to the logger, or `NULL` upon failure
+ */
+static RKLogger* rkPlaceLogger(RKLoggerOrigin origin, void* source,
+                               size_t size, const char* fileName,
+                               const char* title, RKLogStyle style)
+{
+    RKLogger* const logger = rkAcquireLogger(origin, source, size);
+    if (!logger) return NULL;
+
+    FILE* const out = fileName ? rkOpenLogFile(fileName) : stderr;
+    const RKSinkType sink = fileName ? RKLOG_SINK_FILE : RKLOG_SINK_CONSOLE;
+    if (!out || !rkPrepareLogger(logger, sink, out, title, style))
+    {
+        if (out && out != stderr) fclose(out);
+        rkRecycleLogger(logger);
+        return NULL;
+    }
+
     return logger;
 }
 
@@ -437,28 +1393,71 @@ static void rkGenColorPrelude(char* buffer, size_t length, RKLogConfig cfg)
 }
 
 /**
- * @brief Gets the current system time
+ * @brief Counts the days from 1970-01-01 to a date of the proleptic Gregorian
+ * calendar
+ *
+ * @param[in] year
+ *      The year of the date
+ * @param[in] month
+ *      The month of the date, from 1 to 12
+ * @param[in] day
+ *      The day of the month of the date, from 1 to 31
+ *
+ * @return
+ *      The number of days since the epoch, negative before it
+ */
+static int64_t rkDaysFromCivil(int64_t year, int64_t month, int64_t day)
+{
+    year -= month <= 2;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const int64_t yearOfEra = year - era * 400;
+    const int64_t dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) /
+        5 + day - 1;
+    const int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 -
+        yearOfEra / 100 + dayOfYear;
+
+    return era * 146097 + dayOfEra - 719468;
+}
+
+/**
+ * @brief Breaks a point in time down into the local system time
+ *
+ * @param[in] now
+ *      The point in time to break down
  *
  * @return
- *      The current system time
+ *      The local system time at `now`
  */
-static RKTimeStamp rkGetCurrentTime(void)
+static RKTimeStamp rkGetCurrentTime(time_t now)
 {
     RKTimeStamp currTime = {0};
+    currTime.time = (int64_t)now;
+    currTime.dayStart = (int64_t)now;
     
-    struct tm* timeInfo = NULL;
-    const time_t now = time(NULL);
+    // The reentrant variants keep loggers shared between threads safe
+    struct tm timeInfo;
     
 #if defined(RKLOG_PLATFORM_WINDOWS)
-    if (localtime_s(timeInfo, &now) != 0)
+    if (localtime_s(&timeInfo, &now) != 0)
         return currTime;
 #else
-    timeInfo = localtime(&now);
+    if (!localtime_r(&now, &timeInfo))
+        return currTime;
 #endif
 
-    currTime.hours = (uint32_t)timeInfo->tm_hour;
-    currTime.minutes = (uint32_t)timeInfo->tm_min;
-    currTime.seconds = (uint32_t)timeInfo->tm_sec;
+    currTime.hours = (uint32_t)timeInfo.tm_hour;
+    currTime.minutes = (uint32_t)timeInfo.tm_min;
+    currTime.seconds = (uint32_t)timeInfo.tm_sec;
+
+    // Derived from the broken down time alone, as `tm_gmtoff` is not portable
+    const int64_t timeOfDay = timeInfo.tm_hour * 3600 + timeInfo.tm_min * 60 +
+        timeInfo.tm_sec;
+    const int64_t local = rkDaysFromCivil(timeInfo.tm_year + 1900,
+                                          timeInfo.tm_mon + 1,
+                                          timeInfo.tm_mday) * 86400 +
+        timeOfDay;
+    currTime.dayStart = (int64_t)now - timeOfDay;
+    currTime.utcOffset = (int32_t)(local - (int64_t)now);
 
     return currTime;
 }
@@ -474,182 +1473,2332 @@ static RKTimeStamp rkGetCurrentTime(void)
  *      The title of the logger
  * @param[in] tag
  *      The tag of the log message
+ * @param[in] timeStamp
+ *      The local system time the log message is logged at
  */
 static void rkGenLabel(char* buffer, size_t length, const char* title,
-                       const char* tag)
+                       const char* tag, const RKTimeStamp* timeStamp)
 {
-    const RKTimeStamp timeStamp = rkGetCurrentTime();   
     snprintf(
         buffer,
         length,
         RKLOG_FMT_LABEL,
         title,
         tag,
-        timeStamp.hours,
-        timeStamp.minutes,
-        timeStamp.seconds
+        timeStamp->hours,
+        timeStamp->minutes,
+        timeStamp->seconds
     );
 }
 
 /**
- * @brief Internal implementation of the logging operations. This logs a
- * formatted message to `out` using the provided variadic arguments list
+ * @brief Stores `value` as 4 little-endian bytes
  *
- * @param[in] out
- *      The output stream to log to
- * @param[in] title
- *      The title of the logger logging the message
- * @param[in] cfg
- *      The configuration of the log message
- * @param[in] fmt
- *      The format specifier of the log message
- * @param[in] args
- *      The variadic arguments list
+ * @param[in] dst
+ *      The buffer to store the value in
+ * @param[in] value
+ *      The value to store
  */
-static void rkLogInternal(FILE* out, const char* title, RKLogConfig cfg,
-                          const char* fmt, va_list args)
+static void rkStoreU32(unsigned char* dst, uint32_t value)
 {
-#define MAX_PRELUDE_SIZE (64)
-#define MAX_LABEL_SIZE (64 + RKLOG_MAX_LOGGER_TITLE_SIZE)
-#define MAX_MESSAGE_SIZE (256)
-
-    char label[MAX_LABEL_SIZE+1] = {0};
-    char message[MAX_MESSAGE_SIZE+1] = {0};
-    
-    rkGenLabel(label, MAX_LABEL_SIZE, title, cfg.tag);
-    vsnprintf(message, MAX_MESSAGE_SIZE, fmt, args);
-    
-    if (out == stderr)
-    {
-        char prelude[MAX_PRELUDE_SIZE+1] = {0};
-        rkGenColorPrelude(prelude, MAX_PRELUDE_SIZE, cfg);
-
-        fprintf(out, RKLOG_FMT_COLOR_OUTPUT, prelude, label, message);
-    }
-    else
-    {
-        fprintf(out, RKLOG_FMT_OUTPUT, label, message);
-    }
+    dst[0] = (unsigned char)(value);
+    dst[1] = (unsigned char)(value >> 8);
+    dst[2] = (unsigned char)(value >> 16);
+    dst[3] = (unsigned char)(value >> 24);
 }
 
-// --- rklog implementation ---------------------------------------------------
-
-RKLogger* rkDefaultLogger(const char* title)
+/**
+ * @brief Loads a value stored as 4 little-endian bytes
+ *
+ * @param[in] src
+ *      The buffer to load the value from
+ *
+ * @return
+ *      The loaded value
+ */
+static uint32_t rkLoadU32(const unsigned char* src)
 {
-    return rkCreateLogger(title, RKLOG_DEFAULT_LOG_STYLE);
+    return (uint32_t)src[0] | (uint32_t)src[1] << 8 |
+        (uint32_t)src[2] << 16 | (uint32_t)src[3] << 24;
 }
 
-RKLogger* rkDefaultFileLogger(const char* fileName, const char* title)
+/**
+ * @brief Stores `value` as 8 little-endian bytes
+ *
+ * @param[in] dst
+ *      The buffer to store the value in
+ * @param[in] value
+ *      The value to store
+ */
+static void rkStoreU64(unsigned char* dst, uint64_t value)
 {
-    return rkCreateFileLogger(fileName, title, RKLOG_DEFAULT_LOG_STYLE);
+    rkStoreU32(dst, (uint32_t)value);
+    rkStoreU32(dst + 4, (uint32_t)(value >> 32));
 }
 
-RKLogger* rkCreateFileLogger(const char* fileName, const char* title,
-                             RKLogStyle style)
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+/**
+ * @brief Loads a value stored as 8 little-endian bytes
+ *
+ * @param[in] src
+ *      The buffer to load the value from
+ *
+ * @return
+ *      The loaded value
+ */
+static uint64_t rkLoadU64(const unsigned char* src)
 {
-#if defined(RKLOG_PLATFORM_WINDOWS)
-    FILE* out = NULL;
-    if (fopen_s(&out, fileName, "w") != 0)
-        return NULL;
-#else
-    FILE* out = fopen(fileName, "w");
-    if (!out) return NULL;
+    return (uint64_t)rkLoadU32(src) | (uint64_t)rkLoadU32(src + 4) << 32;
+}
 #endif
 
-    return rkNewLogger(out, title, style);
+/**
+ * @brief Tells whether a log message may join the block of an index entry.
+ * Labels only carry the time of day, so a block never crosses into another
+ * local day or UTC offset
+ *
+ * @param[in] entry
+ *      The index entry of the block being filled
+ * @param[in] timeStamp
+ *      The local system time the log message was logged at
+ *
+ * @return
+ *      `true` if the log message fits the block, `false` otherwise
+ */
+static bool rkIndexFits(const RKIndexEntry* entry,
+                        const RKTimeStamp* timeStamp)
+{
+    return entry->messages == 0 ||
+        (entry->dayStart == timeStamp->dayStart &&
+         entry->utcOffset == timeStamp->utcOffset);
 }
 
-RKLogger *rkCreateLogger(const char* title, RKLogStyle style)
+/**
+ * @brief Adds a log message to the statistics of an index entry
+ *
+ * @param[in] entry
+ *      The index entry of the block the log message lands in
+ * @param[in] timeStamp
+ *      The local system time the log message was logged at
+ * @param[in] severity
+ *      The log-severity of the log message
+ */
+static void rkIndexCount(RKIndexEntry* entry, const RKTimeStamp* timeStamp,
+                         RKLogSeverity severity)
 {
-    return rkNewLogger(stderr, title, style);
+    if (entry->messages == 0)
+    {
+        entry->firstTime = timeStamp->time;
+        entry->dayStart = timeStamp->dayStart;
+        entry->utcOffset = timeStamp->utcOffset;
+    }
+    entry->lastTime = timeStamp->time;
+    entry->severities |= (uint32_t)severity;
+    entry->messages++;
 }
 
-void rkCloseLogger(RKLogger* logger)
+/**
+ * @brief Appends an entry to an index file
+ *
+ * @param[in] index
+ *      The index file
+ * @param[in] entry
+ *      The entry to append
+ */
+static void rkIndexAppend(FILE* index, const RKIndexEntry* entry)
 {
-    if (logger->output != stderr)
-        fclose(logger->output);
-
-    free(logger);
+    unsigned char bytes[RKLOG_INDEX_ENTRY_SIZE];
+    rkStoreU64(bytes, entry->offset);
+    rkStoreU64(bytes + 8, entry->length);
+    rkStoreU64(bytes + 16, (uint64_t)entry->firstTime);
+    rkStoreU64(bytes + 24, (uint64_t)entry->lastTime);
+    rkStoreU32(bytes + 32, entry->severities);
+    rkStoreU32(bytes + 36, entry->messages);
+    rkStoreU64(bytes + 40, (uint64_t)entry->dayStart);
+    rkStoreU32(bytes + 48, (uint32_t)entry->utcOffset);
+    rkStoreU32(bytes + 52, 0);
+
+    fwrite(bytes, 1, sizeof(bytes), index);
 }
 
-void rkLogInfo(RKLogger* logger, const char* fmt, ...)
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+/**
+ * @brief Parses an entry of an index file
+ *
+ * @param[in] bytes
+ *      The `RKLOG_INDEX_ENTRY_SIZE` bytes of the entry
+ *
+ * @return
+ *      The parsed entry
+ */
+static RKIndexEntry rkIndexParse(const unsigned char* bytes)
 {
-    va_list args = {0};
-
-    va_start(args, fmt);
-    rkLogInfoArgs(logger, fmt, args);
-    va_end(args);
+    RKIndexEntry entry;
+    entry.offset = rkLoadU64(bytes);
+    entry.length = rkLoadU64(bytes + 8);
+    entry.firstTime = (int64_t)rkLoadU64(bytes + 16);
+    entry.lastTime = (int64_t)rkLoadU64(bytes + 24);
+    entry.severities = rkLoadU32(bytes + 32);
+    entry.messages = rkLoadU32(bytes + 36);
+    entry.dayStart = (int64_t)rkLoadU64(bytes + 40);
+    entry.utcOffset = (int32_t)rkLoadU32(bytes + 48);
+
+    return entry;
 }
+#endif
 
-void rkLogWarning(RKLogger* logger, const char* fmt, ...)
+/**
+ * @brief Ends the current block of a plain or uring file logger, appending its
+ * entry to the index, and starts a new block after it
+ *
+ * @param[in] logger
+ *      A pointer to the file logger
+ */
+static void rkIndexCut(RKLogger* logger)
 {
-    va_list args = {0};
+    RKIndexEntry* const block = &logger->indexBlock;
+    if (logger->index)
+        rkIndexAppend(logger->index, block);
 
-    va_start(args, fmt);
-    rkLogWarningArgs(logger, fmt, args);
-    va_end(args);
+    const uint64_t next = block->offset + block->length;
+    memset(block, 0, sizeof(*block));
+    block->offset = next;
 }
 
-void rkLogError(RKLogger* logger, const char* fmt, ...)
+/**
+ * @brief Accounts a log message written to a plain or uring file logger. Once
+ * the current block has grown past `RKLOG_INDEX_BLOCK_SIZE` its entry is
+ * appended to the index and a new block starts after it
+ *
+ * @param[in] logger
+ *      A pointer to the file logger
+ * @param[in] length
+ *      The number of bytes the log message took up in the file
+ * @param[in] timeStamp
+ *      The local system time the log message was logged at
+ * @param[in] severity
+ *      The log-severity of the log message
+ */
+static void rkIndexRecord(RKLogger* logger, size_t length,
+                          const RKTimeStamp* timeStamp,
+                          RKLogSeverity severity)
 {
-    va_list args = {0};
+    RKIndexEntry* const block = &logger->indexBlock;
+    if (!rkIndexFits(block, timeStamp))
+        rkIndexCut(logger);
 
-    va_start(args, fmt);
-    rkLogErrorArgs(logger, fmt, args);
-    va_end(args);
+    rkIndexCount(block, timeStamp, severity);
+    block->length += length;
+
+    if (block->length >= RKLOG_INDEX_BLOCK_SIZE)
+        rkIndexCut(logger);
 }
 
-void rkLogFatal(RKLogger* logger, const char* fmt, ...)
+/**
+ * @brief Ends the current block of a plain or uring file logger early so that
+ * the index covers every log message written so far, then flushes the index
+ *
+ * @param[in] logger
+ *      A pointer to the file logger
+ */
+static void rkIndexFlush(RKLogger* logger)
 {
-    va_list args = {0};
+    if (!logger->index)
+        return;
 
-    va_start(args, fmt);
-    rkLogFatalArgs(logger, fmt, args);
-    va_end(args);
+    if (logger->indexBlock.messages > 0)
+        rkIndexCut(logger);
+    fflush(logger->index);
 }
 
-void rkLogInfoArgs(RKLogger* logger, const char* fmt, va_list args)
+/**
+ * @brief Computes the FNV-1a hash of a block, used to detect damaged blocks
+ *
+ * @param[in] data
+ *      The bytes to hash
+ * @param[in] length
+ *      The number of bytes to hash
+ *
+ * @return
+ *      The hash of `data`
+ */
+static uint32_t rkChecksum(const unsigned char* data, size_t length)
 {
-    rkLogInternal(
-        logger->output,
-        logger->title,
-        logger->style.cfgInfo,
-        fmt,
-        args
-    );
-}
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++)
+        hash = (hash ^ data[i]) * 16777619u;
 
-void rkLogWarningArgs(RKLogger* logger, const char* fmt, va_list args)
-{
-    rkLogInternal(
-        logger->output,
-        logger->title,
-        logger->style.cfgWarning,
-        fmt,
-        args
-    );
+    return hash;
 }
 
-void rkLogErrorArgs(RKLogger* logger, const char* fmt, va_list args)
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+/**
+ * @brief Writes a sequence length using the extension bytes of the block
+ * format: every `255` adds to the length until a smaller byte ends it
+ *
+ * @param[in] op
+ *      The position to write the extension bytes at
+ * @param[in] length
+ *      The part of the length that did not fit in the token
+ *
+ * @return
+ *      The position after the extension bytes
+ */
+static unsigned char* rkLzPutLength(unsigned char* op, size_t length)
 {
-    rkLogInternal(
-        logger->output,
-        logger->title,
-        logger->style.cfgError,
-        fmt,
-        args
-    );
+    while (length >= 255)
+    {
+        *op++ = 255;
+        length -= 255;
+    }
+    *op++ = (unsigned char)length;
+
+    return op;
 }
 
-void rkLogFatalArgs(RKLogger* logger, const char* fmt, va_list args)
-{
-    rkLogInternal(
-        logger->output,
-        logger->title,
-        logger->style.cfgFatalError,
-        fmt,
-        args
+/**
+ * @brief Compresses a block with a small LZ77 codec. Each sequence is a token
+ * holding the literal length and match length in its high and low nibble,
+ * followed by the literals and a 2-byte match offset. The final sequence only
+ * carries literals
+ *
+ * @param[in] src
+ *      The bytes to compress, at most `RKLOG_COMPRESS_BLOCK_SIZE` of them
+ * @param[in] length
+ *      The number of bytes to compress
+ * @param[in] dst
+ *      The output buffer, at least `RKLOG_COMPRESS_BOUND(length)` bytes
+ *
+ * @return
+ *      The number of compressed bytes written to `dst`
+ */
+static size_t rkLzCompress(const unsigned char* src, size_t length,
+                           unsigned char* dst)
+{
+    uint32_t table[RKLOG_COMPRESS_HASH_SIZE];
+    memset(table, 0xff, sizeof(table));
+
+    unsigned char* op = dst;
+    size_t anchor = 0;
+    size_t ip = 0;
+
+    while (ip + RKLOG_COMPRESS_MIN_MATCH <= length)
+    {
+        const uint32_t sequence = rkLoadU32(src + ip);
+        const uint32_t hash = (sequence * 2654435761u) >> 20;
+        const uint32_t candidate = table[hash];
+        table[hash] = (uint32_t)ip;
+
+        if (candidate == UINT32_MAX || ip - candidate > 0xffff ||
+            rkLoadU32(src + candidate) != sequence)
+        {
+            ip++;
+            continue;
+        }
+
+        size_t matchLength = RKLOG_COMPRESS_MIN_MATCH;
+        while (ip + matchLength < length &&
+               src[candidate + matchLength] == src[ip + matchLength])
+            matchLength++;
+
+        const size_t literals = ip - anchor;
+        const size_t extra = matchLength - RKLOG_COMPRESS_MIN_MATCH;
+        unsigned char* const token = op++;
+        *token = (unsigned char)(((literals < 15 ? literals : 15) << 4) |
+                                 (extra < 15 ? extra : 15));
+        if (literals >= 15)
+            op = rkLzPutLength(op, literals - 15);
+        memcpy(op, src + anchor, literals);
+        op += literals;
+
+        const size_t offset = ip - candidate;
+        *op++ = (unsigned char)(offset);
+        *op++ = (unsigned char)(offset >> 8);
+        if (extra >= 15)
+            op = rkLzPutLength(op, extra - 15);
+
+        ip += matchLength;
+        anchor = ip;
+    }
+
+    const size_t literals = length - anchor;
+    *op++ = (unsigned char)((literals < 15 ? literals : 15) << 4);
+    if (literals >= 15)
+        op = rkLzPutLength(op, literals - 15);
+    memcpy(op, src + anchor, literals);
+    op += literals;
+
+    return (size_t)(op - dst);
+}
+#endif
+
+/**
+ * @brief Reads a sequence length continued in extension bytes
+ *
+ * @param[in, out] ip
+ *      The position of the extension bytes, advanced past them
+ * @param[in] end
+ *      The end of the compressed input
+ * @param[in, out] length
+ *      The length from the token, extended in place
+ *
+ * @return
+ *      `true` on success, `false` if the input ended early
+ */
+static bool rkLzGetLength(const unsigned char** ip, const unsigned char* end,
+                          size_t* length)
+{
+    unsigned char byte = 255;
+    while (byte == 255)
+    {
+        if (*ip >= end) return false;
+        byte = *(*ip)++;
+        *length += byte;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Decompresses a block produced by `rkLzCompress`, checking every
+ * length and offset against the bounds of both buffers
+ *
+ * @param[in] src
+ *      The compressed bytes
+ * @param[in] length
+ *      The number of compressed bytes
+ * @param[in] dst
+ *      The output buffer
+ * @param[in] capacity
+ *      The size of the output buffer
+ *
+ * @return
+ *      The number of decompressed bytes, or `SIZE_MAX` if the block is damaged
+ */
+static size_t rkLzDecompress(const unsigned char* src, size_t length,
+                             unsigned char* dst, size_t capacity)
+{
+    const unsigned char* ip = src;
+    const unsigned char* const end = src + length;
+    size_t op = 0;
+
+    while (ip < end)
+    {
+        const unsigned char token = *ip++;
+
+        size_t literals = token >> 4;
+        if (literals == 15 && !rkLzGetLength(&ip, end, &literals))
+            return SIZE_MAX;
+        if (literals > (size_t)(end - ip) || literals > capacity - op)
+            return SIZE_MAX;
+        memcpy(dst + op, ip, literals);
+        ip += literals;
+        op += literals;
+
+        if (ip == end)
+            break;
+
+        if (end - ip < 2) return SIZE_MAX;
+        const size_t offset = (size_t)ip[0] | (size_t)ip[1] << 8;
+        ip += 2;
+
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !rkLzGetLength(&ip, end, &matchLength))
+            return SIZE_MAX;
+        matchLength += RKLOG_COMPRESS_MIN_MATCH;
+
+        if (offset == 0 || offset > op || matchLength > capacity - op)
+            return SIZE_MAX;
+
+        // Matches may overlap their own output, so copy byte by byte
+        for (size_t i = 0; i < matchLength; i++, op++)
+            dst[op] = dst[op - offset];
+    }
+
+    return op;
+}
+
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+/**
+ * @brief Builds a block of a compressed log file: a header holding the magic
+ * bytes, the raw size, the stored size and a checksum of the raw bytes,
+ * followed by the compressed bytes. Blocks that do not shrink are stored as is
+ *
+ * @param[in] raw
+ *      The raw log messages
+ * @param[in] length
+ *      The number of raw bytes, at most `RKLOG_COMPRESS_BLOCK_SIZE`
+ * @param[in] block
+ *      The output buffer, at least `RKLOG_COMPRESS_HEADER_SIZE` plus
+ *      `RKLOG_COMPRESS_BOUND(length)` bytes
+ *
+ * @return
+ *      The total size of the block in bytes
+ */
+static size_t rkEncodeBlock(const unsigned char* raw, size_t length,
+                            unsigned char* block)
+{
+    unsigned char* const payload = block + RKLOG_COMPRESS_HEADER_SIZE;
+    size_t stored = rkLzCompress(raw, length, payload);
+    if (stored >= length)
+    {
+        memcpy(payload, raw, length);
+        stored = length;
+    }
+
+    memcpy(block, RKLOG_COMPRESS_MAGIC, 4);
+    rkStoreU32(block + 4, (uint32_t)length);
+    rkStoreU32(block + 8, (uint32_t)stored);
+    rkStoreU32(block + 12, rkChecksum(raw, length));
+
+    return RKLOG_COMPRESS_HEADER_SIZE + stored;
+}
+#endif
+
+/**
+ * @brief Decodes one block of a compressed log file from memory
+ *
+ * @param[in] header
+ *      The `RKLOG_COMPRESS_HEADER_SIZE` header bytes of the block
+ * @param[in] payload
+ *      The stored bytes following the header
+ * @param[in] raw
+ *      The output buffer, at least `RKLOG_COMPRESS_BLOCK_SIZE` bytes
+ *
+ * @return
+ *      The number of raw bytes, or `SIZE_MAX` if the block is damaged
+ */
+static size_t rkDecodeBlock(const unsigned char* header,
+                            const unsigned char* payload, unsigned char* raw)
+{
+    const size_t length = rkLoadU32(header + 4);
+    const size_t stored = rkLoadU32(header + 8);
+    if (length > RKLOG_COMPRESS_BLOCK_SIZE)
+        return SIZE_MAX;
+
+    if (stored == length)
+        memcpy(raw, payload, length);
+    else if (rkLzDecompress(payload, stored, raw, length) != length)
+        return SIZE_MAX;
+
+    if (rkChecksum(raw, length) != rkLoadU32(header + 12))
+        return SIZE_MAX;
+
+    return length;
+}
+
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+/**
+ * @brief Tells whether a disconnected socket logger may try to reconnect. After
+ * a failed attempt it waits `RKLOG_SOCKET_MAX_DELAY` seconds, so that an agent
+ * outage does not cost a handful of syscalls per log message
+ *
+ * @param[in] logger
+ *      A pointer to the socket logger
+ * @param[in] now
+ *      The current time
+ *
+ * @return
+ *      `true` if a connection attempt is due, `false` otherwise
+ */
+static bool rkSocketMayConnect(const RKLogger* logger, time_t now)
+{
+    return logger->connectFailedAt == 0 ||
+        now - logger->connectFailedAt >= RKLOG_SOCKET_MAX_DELAY;
+}
+
+/**
+ * @brief Tries to (re)connect a socket logger to its agent, unless the last
+ * attempt failed too recently. The socket is put in non-blocking mode so that
+ * later sends never stall the caller
+ *
+ * @param[in] logger
+ *      A pointer to the socket logger
+ *
+ * @return
+ *      `true` if the logger is connected, `false` otherwise
+ */
+static bool rkSocketConnect(RKLogger* logger)
+{
+    if (logger->socketFd >= 0)
+        return true;
+
+    const time_t now = time(NULL);
+    if (!rkSocketMayConnect(logger, now))
+        return false;
+    logger->connectFailedAt = now;
+
+    const int type = logger->socketType == RKLOG_SOCKET_STREAM
+        ? SOCK_STREAM
+        : SOCK_DGRAM;
+    const int fd = socket(AF_UNIX, type, 0);
+    if (fd < 0) return false;
+
+    const int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0)
+    {
+        close(fd);
+        return false;
+    }
+#if defined(SO_NOSIGPIPE)
+    const int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    memcpy(addr.sun_path, logger->socketPath, sizeof(logger->socketPath));
+
+    if (connect(fd, (const struct sockaddr*)&addr, sizeof(addr)) != 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    logger->socketFd = fd;
+    logger->connectFailedAt = 0;
+    return true;
+}
+
+/**
+ * @brief Drops the connection of a socket logger so that the next send
+ * reconnects to the (possibly restarted) agent
+ *
+ * @param[in] logger
+ *      A pointer to the socket logger
+ */
+static void rkSocketDisconnect(RKLogger* logger)
+{
+    if (logger->socketFd < 0)
+        return;
+
+    close(logger->socketFd);
+    logger->socketFd = -1;
+}
+
+/**
+ * @brief Sends as much of the pending log messages as the agent accepts
+ * without blocking. Datagrams always carry whole log messages, batching as
+ * many as fit in `RKLOG_SOCKET_BATCH_SIZE`
+ *
+ * @param[in] logger
+ *      A pointer to the socket logger
+ */
+static void rkSocketSend(RKLogger* logger)
+{
+    // The socket is non-blocking already, so no `MSG_DONTWAIT` is needed
+    int flags = 0;
+#if defined(MSG_NOSIGNAL)
+    flags |= MSG_NOSIGNAL;
+#endif
+
+    size_t sent = 0;
+    while (sent < logger->pendingLength && rkSocketConnect(logger))
+    {
+        const char* const batch = logger->pending + sent;
+        size_t length = logger->pendingLength - sent;
+
+        if (logger->socketType == RKLOG_SOCKET_DATAGRAM &&
+            length > RKLOG_SOCKET_BATCH_SIZE)
+        {
+            length = RKLOG_SOCKET_BATCH_SIZE;
+            while (length > 0 && batch[length - 1] != '\n')
+                length--;
+            if (length == 0)
+                length = RKLOG_SOCKET_BATCH_SIZE;
+        }
+
+        const ssize_t result = send(logger->socketFd, batch, length, flags);
+        if (result > 0)
+        {
+            sent += (size_t)result;
+            logger->partialRecord = logger->pending[sent - 1] != '\n';
+            continue;
+        }
+
+        if (result < 0 && errno == EINTR)
+            continue;
+        if (result < 0 && errno != EAGAIN && errno != EWOULDBLOCK &&
+            errno != ENOBUFS)
+        {
+            rkSocketDisconnect(logger);
+
+            // The agent got the start of a log message on the old stream, so
+            // drop the rest of it rather than send a torn line to the new one
+            if (logger->partialRecord)
+            {
+                while (sent < logger->pendingLength &&
+                       logger->pending[sent] != '\n')
+                    sent++;
+                if (sent < logger->pendingLength)
+                    sent++;
+                logger->partialRecord = false;
+            }
+        }
+        break;
+    }
+
+    if (sent > 0)
+    {
+        memmove(logger->pending, logger->pending + sent,
+                logger->pendingLength - sent);
+        logger->pendingLength -= sent;
+    }
+}
+
+/**
+ * @brief Queues a log message on a socket logger. The queue is sent once a
+ * full batch has accumulated, when the message is an error or fatal one, or
+ * when the oldest queued message has waited `RKLOG_SOCKET_MAX_DELAY` seconds.
+ * The message is dropped if the bounded buffer is still full after trying to
+ * send, or right away while the agent is unreachable and no reconnect is due
+ *
+ * @param[in] logger
+ *      A pointer to the socket logger
+ * @param[in] record
+ *      The log message, terminated with a newline
+ * @param[in] length
+ *      The length of the log message in bytes
+ * @param[in] now
+ *      The time the log message was logged at
+ * @param[in] severity
+ *      The log-severity of the log message
+ */
+static void rkSocketWrite(RKLogger* logger, const char* record, size_t length,
+                          time_t now, RKLogSeverity severity)
+{
+    if (logger->pendingLength + length > RKLOG_SOCKET_BUFFER_SIZE &&
+        (logger->socketFd >= 0 || rkSocketMayConnect(logger, now)))
+        rkSocketSend(logger);
+
+    if (logger->pendingLength + length > RKLOG_SOCKET_BUFFER_SIZE)
+    {
+        logger->droppedMessages++;
+        return;
+    }
+
+    if (logger->pendingLength == 0)
+        logger->pendingSince = now;
+    memcpy(logger->pending + logger->pendingLength, record, length);
+    logger->pendingLength += length;
+
+    if (logger->pendingLength >= RKLOG_SOCKET_BATCH_SIZE ||
+        (severity & (RKLOG_SEVERITY_ERROR | RKLOG_SEVERITY_FATAL)) ||
+        now - logger->pendingSince >= RKLOG_SOCKET_MAX_DELAY)
+        rkSocketSend(logger);
+}
+
+#if defined(RKLOG_HAS_IO_URING)
+/**
+ * @brief Sets up an io_uring instance and registers the buffer pool of
+ * `logger` with it. On failure the ring is left with `fd == -1`
+ *
+ * @param[in] logger
+ *      A pointer to the uring file logger
+ *
+ * @return
+ *      `true` if io_uring is usable, `false` otherwise
+ */
+static bool rkUringSetup(RKLogger* logger)
+{
+    RKUring* const ring = &logger->ring;
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+
+    const int fd = (int)syscall(__NR_io_uring_setup,
+                                RKLOG_URING_BUFFER_COUNT, &params);
+    if (fd < 0) return false;
+
+    ring->sqRingSize = params.sq_off.array +
+        params.sq_entries * sizeof(unsigned);
+    ring->cqRingSize = params.cq_off.cqes +
+        params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        if (ring->cqRingSize > ring->sqRingSize)
+            ring->sqRingSize = ring->cqRingSize;
+        ring->cqRingSize = ring->sqRingSize;
+    }
+
+    ring->sqRing = mmap(NULL, ring->sqRingSize, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | RKLOG_MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (ring->sqRing == MAP_FAILED)
+    {
+        close(fd);
+        return false;
+    }
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        ring->cqRing = ring->sqRing;
+    }
+    else
+    {
+        ring->cqRing = mmap(NULL, ring->cqRingSize, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | RKLOG_MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (ring->cqRing == MAP_FAILED)
+        {
+            munmap(ring->sqRing, ring->sqRingSize);
+            close(fd);
+            return false;
+        }
+    }
+
+    ring->sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes = (struct io_uring_sqe*)mmap(NULL, ring->sqesSize,
+                                            PROT_READ | PROT_WRITE,
+                                            MAP_SHARED | RKLOG_MAP_POPULATE, fd,
+                                            IORING_OFF_SQES);
+
+    struct iovec iovecs[RKLOG_URING_BUFFER_COUNT];
+    for (size_t i = 0; i < RKLOG_URING_BUFFER_COUNT; i++)
+    {
+        iovecs[i].iov_base = logger->buffers + i * RKLOG_URING_BUFFER_SIZE;
+        iovecs[i].iov_len = RKLOG_URING_BUFFER_SIZE;
+    }
+
+    if (ring->sqes == MAP_FAILED ||
+        syscall(__NR_io_uring_register, fd, IORING_REGISTER_BUFFERS,
+                iovecs, RKLOG_URING_BUFFER_COUNT) != 0)
+    {
+        if (ring->sqes != MAP_FAILED)
+            munmap(ring->sqes, ring->sqesSize);
+        if (ring->cqRing != ring->sqRing)
+            munmap(ring->cqRing, ring->cqRingSize);
+        munmap(ring->sqRing, ring->sqRingSize);
+        close(fd);
+        return false;
+    }
+
+    char* const sq = (char*)ring->sqRing;
+    char* const cq = (char*)ring->cqRing;
+    ring->sqHead = (unsigned*)(sq + params.sq_off.head);
+    ring->sqTail = (unsigned*)(sq + params.sq_off.tail);
+    ring->sqMask = (unsigned*)(sq + params.sq_off.ring_mask);
+    ring->sqArray = (unsigned*)(sq + params.sq_off.array);
+    ring->cqHead = (unsigned*)(cq + params.cq_off.head);
+    ring->cqTail = (unsigned*)(cq + params.cq_off.tail);
+    ring->cqMask = (unsigned*)(cq + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe*)(cq + params.cq_off.cqes);
+    ring->toSubmit = 0;
+    ring->inFlight = 0;
+    ring->fd = fd;
+
+    return true;
+}
+
+/**
+ * @brief Releases the io_uring instance of `logger`, if there is one
+ *
+ * @param[in] logger
+ *      A pointer to the uring file logger
+ */
+static void rkUringTeardown(RKLogger* logger)
+{
+    RKUring* const ring = &logger->ring;
+    if (ring->fd < 0)
+        return;
+
+    syscall(__NR_io_uring_register, ring->fd, IORING_UNREGISTER_BUFFERS,
+            NULL, 0);
+    munmap(ring->sqes, ring->sqesSize);
+    if (ring->cqRing != ring->sqRing)
+        munmap(ring->cqRing, ring->cqRingSize);
+    munmap(ring->sqRing, ring->sqRingSize);
+    close(ring->fd);
+    ring->fd = -1;
+}
+
+/**
+ * @brief Hands all queued writes to the kernel, optionally waiting for some
+ * of the outstanding writes to complete
+ *
+ * @param[in] logger
+ *      A pointer to the uring file logger
+ * @param[in] minComplete
+ *      The number of completions to wait for
+ *
+ * @return
+ *      `true` on success, `false` if the kernel refused the call
+ */
+static bool rkUringEnter(RKLogger* logger, unsigned minComplete)
+{
+    RKUring* const ring = &logger->ring;
+    const unsigned flags = minComplete > 0 ? IORING_ENTER_GETEVENTS : 0;
+
+    for (;;)
+    {
+        const long result = syscall(__NR_io_uring_enter, ring->fd,
+                                    ring->toSubmit, minComplete, flags,
+                                    NULL, 0);
+        if (result < 0 && errno == EINTR)
+            continue;
+        if (result < 0)
+            return false;
+
+        ring->toSubmit -= (unsigned)result;
+        return true;
+    }
+}
+#endif
+
+/**
+ * @brief Writes the first `length` bytes of a buffer to the file of `logger`
+ * at `offset` with plain blocking `write` calls. The caller holds the logger
+ * lock, so seeking first cannot race with other writers
+ *
+ * @param[in] logger
+ *      A pointer to the uring file logger
+ * @param[in] data
+ *      The bytes to write
+ * @param[in] length
+ *      The number of bytes to write
+ * @param[in] offset
+ *      The offset in the file to write at
+ */
+static void rkFileWriteAt(RKLogger* logger, const char* data, size_t length,
+                          uint64_t offset)
+{
+    if (lseek(logger->fileFd, (off_t)offset, SEEK_SET) < 0)
+        return;
+
+    while (length > 0)
+    {
+        const ssize_t result = write(logger->fileFd, data, length);
+        if (result < 0)
+        {
+            if (errno == EINTR) continue;
+            return;
+        }
+
+        data += result;
+        length -= (size_t)result;
+    }
+}
+
+/**
+ * @brief Moves finished writes out of the completion queue and recycles their
+ * buffers into the pool. Writes that the kernel only partially completed are
+ * finished synchronously
+ *
+ * @param[in] logger
+ *      A pointer to the uring file logger
+ */
+static void rkUringReap(RKLogger* logger)
+{
+#if defined(RKLOG_HAS_IO_URING)
+    RKUring* const ring = &logger->ring;
+    if (ring->fd < 0)
+        return;
+
+    unsigned head = *ring->cqHead;
+    const unsigned tail = __atomic_load_n(ring->cqTail, __ATOMIC_ACQUIRE);
+
+    while (head != tail)
+    {
+        const struct io_uring_cqe* const cqe =
+            &ring->cqes[head & *ring->cqMask];
+        const uint32_t index = (uint32_t)cqe->user_data;
+        const size_t written = cqe->res > 0 ? (size_t)cqe->res : 0;
+
+        if (written < logger->bufferLengths[index])
+        {
+            rkFileWriteAt(
+                logger,
+                logger->buffers + index * RKLOG_URING_BUFFER_SIZE + written,
+                logger->bufferLengths[index] - written,
+                logger->bufferOffsets[index] + written
+            );
+        }
+
+        logger->freeBuffers[logger->freeCount++] = index;
+        ring->inFlight--;
+        head++;
+    }
+
+    __atomic_store_n(ring->cqHead, head, __ATOMIC_RELEASE);
+#else
+    (void)logger;
+#endif
+}
+
+#if defined(RKLOG_HAS_IO_URING)
+/**
+ * @brief Gives up on io_uring after the kernel refused a submission. The ring
+ * is torn down, which waits for the writes it still uses the buffers for, and
+ * every queued buffer is written again with plain `write` calls. Rewriting
+ * bytes the kernel already wrote is harmless, as they land at the same offsets
+ *
+ * @param[in] logger
+ *      A pointer to the uring file logger
+ */
+static void rkUringFallback(RKLogger* logger)
+{
+    rkUringReap(logger);
+    rkUringTeardown(logger);
+
+    bool idle[RKLOG_URING_BUFFER_COUNT] = {false};
+    for (size_t i = 0; i < logger->freeCount; i++)
+        idle[logger->freeBuffers[i]] = true;
+    if (logger->fillBuffer >= 0)
+        idle[logger->fillBuffer] = true;
+
+    for (uint32_t i = 0; i < RKLOG_URING_BUFFER_COUNT; i++)
+    {
+        if (idle[i])
+            continue;
+
+        rkFileWriteAt(logger, logger->buffers + i * RKLOG_URING_BUFFER_SIZE,
+                      logger->bufferLengths[i], logger->bufferOffsets[i]);
+        logger->freeBuffers[logger->freeCount++] = i;
+    }
+
+    logger->ring.toSubmit = 0;
+    logger->ring.inFlight = 0;
+}
+#endif
+
+/**
+ * @brief Queues the buffer being filled to be written to the file. With
+ * io_uring the write is submitted right away without waiting for it,
+ * otherwise the buffer gets written synchronously
+ *
+ * @param[in] logger
+ *      A pointer to the uring file logger
+ * @param[in] length
+ *      The number of bytes filled in the buffer
+ */
+static void rkUringQueue(RKLogger* logger, size_t length)
+{
+    const uint32_t index = (uint32_t)logger->fillBuffer;
+    char* const buffer = logger->buffers + index * RKLOG_URING_BUFFER_SIZE;
+
+    logger->fillBuffer = -1;
+    logger->bufferLengths[index] = length;
+    logger->bufferOffsets[index] = logger->fileOffset;
+    logger->fileOffset += length;
+
+#if defined(RKLOG_HAS_IO_URING)
+    RKUring* const ring = &logger->ring;
+    if (ring->fd >= 0)
+    {
+        const unsigned tail = *ring->sqTail;
+        const unsigned slot = tail & *ring->sqMask;
+        struct io_uring_sqe* const sqe = &ring->sqes[slot];
+
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = IORING_OP_WRITE_FIXED;
+        sqe->fd = logger->fileFd;
+        sqe->addr = (uint64_t)(uintptr_t)buffer;
+        sqe->len = (uint32_t)length;
+        sqe->off = logger->bufferOffsets[index];
+        sqe->buf_index = (uint16_t)index;
+        sqe->user_data = index;
+
+        ring->sqArray[slot] = slot;
+        __atomic_store_n(ring->sqTail, tail + 1, __ATOMIC_RELEASE);
+        ring->toSubmit++;
+        ring->inFlight++;
+
+        if (!rkUringEnter(logger, 0))
+            rkUringFallback(logger);
+        return;
+    }
+#endif
+
+    rkFileWriteAt(logger, buffer, length, logger->bufferOffsets[index]);
+    logger->freeBuffers[logger->freeCount++] = index;
+}
+
+/**
+ * @brief Makes sure `logger` has a buffer to fill, waiting for an outstanding
+ * write to complete if the whole pool is in flight
+ *
+ * @param[in] logger
+ *      A pointer to the uring file logger
+ */
+static void rkUringAcquire(RKLogger* logger)
+{
+    if (logger->fillBuffer >= 0)
+        return;
+
+    rkUringReap(logger);
+#if defined(RKLOG_HAS_IO_URING)
+    while (logger->freeCount == 0)
+    {
+        if (!rkUringEnter(logger, 1))
+        {
+            rkUringFallback(logger);
+            break;
+        }
+        rkUringReap(logger);
+    }
+#endif
+
+    logger->fillBuffer = (int32_t)logger->freeBuffers[--logger->freeCount];
+    logger->bufferLengths[logger->fillBuffer] = 0;
+}
+
+/**
+ * @brief Formats a log message straight into the buffer being filled,
+ * queueing the buffer for writing first if the message would not fit
+ *
+ * @param[in] logger
+ *      A pointer to the uring file logger
+ * @param[in] label
+ *      The label of the log message
+ * @param[in] message
+ *      The log message itself
+ *
+ * @return
+ *      The number of bytes the log message took up in the file
+ */
+static size_t rkUringWrite(RKLogger* logger, const char* label,
+                           const char* message)
+{
+    rkUringAcquire(logger);
+
+    // Room for the label, the message, the newline and the terminating null
+    const size_t needed = strlen(label) + strlen(message) + 2;
+    size_t filled = logger->bufferLengths[logger->fillBuffer];
+    if (filled + needed > RKLOG_URING_BUFFER_SIZE)
+    {
+        rkUringQueue(logger, filled);
+        rkUringAcquire(logger);
+        filled = 0;
+    }
+
+    char* const buffer = logger->buffers +
+        (size_t)logger->fillBuffer * RKLOG_URING_BUFFER_SIZE;
+    const int length = snprintf(buffer + filled,
+                                RKLOG_URING_BUFFER_SIZE - filled,
+                                RKLOG_FMT_OUTPUT, label, message);
+    if (length <= 0)
+        return 0;
+
+    logger->bufferLengths[logger->fillBuffer] = filled + (size_t)length;
+    return (size_t)length;
+}
+
+/**
+ * @brief Writes out the partially filled buffer and waits until every
+ * outstanding write of `logger` has reached the file
+ *
+ * @param[in] logger
+ *      A pointer to the uring file logger
+ */
+static void rkUringFlush(RKLogger* logger)
+{
+    if (logger->fillBuffer >= 0)
+    {
+        const size_t filled = logger->bufferLengths[logger->fillBuffer];
+        if (filled > 0)
+            rkUringQueue(logger, filled);
+        else
+            logger->freeBuffers[logger->freeCount++] =
+                (uint32_t)logger->fillBuffer;
+        logger->fillBuffer = -1;
+    }
+
+#if defined(RKLOG_HAS_IO_URING)
+    while (logger->ring.fd >= 0 && logger->ring.inFlight > 0)
+    {
+        if (!rkUringEnter(logger, logger->ring.inFlight))
+        {
+            rkUringFallback(logger);
+            break;
+        }
+        rkUringReap(logger);
+    }
+#endif
+}
+
+/**
+ * @brief Writes all of `data` to a file descriptor, retrying partial writes
+ *
+ * @param[in] fd
+ *      The file descriptor to write to
+ * @param[in] data
+ *      The bytes to write
+ * @param[in] length
+ *      The number of bytes to write
+ */
+static void rkWriteAll(int fd, const char* data, size_t length)
+{
+    while (length > 0)
+    {
+        const ssize_t result = write(fd, data, length);
+        if (result < 0)
+        {
+            if (errno == EINTR) continue;
+            return;
+        }
+
+        data += result;
+        length -= (size_t)result;
+    }
+}
+
+/**
+ * @brief Hands the block being filled to the compression thread and moves on
+ * to the next free block, waiting only if every block is still queued. Must be
+ * called with `mutex` held and `fillReady` set
+ *
+ * @param[in] compressor
+ *      A pointer to the compression state of the logger
+ */
+static void rkCompressorQueue(RKCompressor* compressor)
+{
+    compressor->fillReady = false;
+    compressor->count++;
+    pthread_cond_signal(&compressor->queued);
+
+    while (compressor->count == RKLOG_COMPRESS_BLOCK_COUNT)
+        pthread_cond_wait(&compressor->done, &compressor->mutex);
+
+    compressor->fillIndex = (compressor->head + compressor->count) %
+        RKLOG_COMPRESS_BLOCK_COUNT;
+    compressor->lengths[compressor->fillIndex] = 0;
+    memset(&compressor->stats[compressor->fillIndex], 0,
+           sizeof(RKIndexEntry));
+
+    // Wake the threads that found no fill block while this one waited
+    compressor->fillReady = true;
+    pthread_cond_broadcast(&compressor->done);
+}
+
+/**
+ * @brief Waits until a block is ready to be filled. Must be called with
+ * `mutex` held
+ *
+ * @param[in] compressor
+ *      A pointer to the compression state of the logger
+ */
+static void rkCompressorWaitFill(RKCompressor* compressor)
+{
+    while (!compressor->fillReady)
+        pthread_cond_wait(&compressor->done, &compressor->mutex);
+}
+
+/**
+ * @brief Entry point of the background compression thread. It compresses and
+ * writes queued blocks in order until told to stop with an empty queue. While
+ * idle it queues the block being filled once its first log message is
+ * `RKLOG_COMPRESS_MAX_DELAY` seconds old, so quiet loggers reach the file too
+ *
+ * @param[in] arg
+ *      A pointer to the `RKCompressor` of the logger
+ *
+ * @return
+ *      Always `NULL`
+ */
+static void* rkCompressorMain(void* arg)
+{
+    RKCompressor* const compressor = (RKCompressor*)arg;
+
+    pthread_mutex_lock(&compressor->mutex);
+    for (;;)
+    {
+        while (compressor->count == 0
+               ? !compressor->stop
+               : compressor->writers[compressor->head] > 0)
+        {
+            const RKIndexEntry* const fill =
+                &compressor->stats[compressor->fillIndex];
+            if (compressor->count > 0 || !compressor->fillReady ||
+                fill->messages == 0)
+            {
+                pthread_cond_wait(&compressor->queued, &compressor->mutex);
+                continue;
+            }
+
+            const time_t due =
+                (time_t)fill->firstTime + RKLOG_COMPRESS_MAX_DELAY;
+            if (time(NULL) >= due)
+            {
+                rkCompressorQueue(compressor);
+                continue;
+            }
+
+            struct timespec deadline;
+            deadline.tv_sec = due;
+            deadline.tv_nsec = 0;
+            pthread_cond_timedwait(&compressor->queued, &compressor->mutex,
+                                   &deadline);
+        }
+        if (compressor->count == 0)
+            break;
+
+        const size_t index = compressor->head;
+        FILE* const indexFile = compressor->index;
+        pthread_mutex_unlock(&compressor->mutex);
+
+        const size_t length = rkEncodeBlock(
+            (const unsigned char*)compressor->blocks +
+                index * RKLOG_COMPRESS_BLOCK_SIZE,
+            compressor->lengths[index],
+            (unsigned char*)compressor->scratch
+        );
+        rkWriteAll(compressor->fd, compressor->scratch, length);
+
+        RKIndexEntry* const stats = &compressor->stats[index];
+        stats->offset = compressor->fileOffset;
+        stats->length = length;
+        compressor->fileOffset += length;
+        if (indexFile)
+            rkIndexAppend(indexFile, stats);
+
+        pthread_mutex_lock(&compressor->mutex);
+        compressor->head = (compressor->head + 1) % RKLOG_COMPRESS_BLOCK_COUNT;
+        compressor->count--;
+        pthread_cond_broadcast(&compressor->done);
+    }
+    pthread_mutex_unlock(&compressor->mutex);
+
+    return NULL;
+}
+
+/**
+ * @brief Copies a log message into the block being filled, queueing the block
+ * for compression once the message no longer fits
+ *
+ * @param[in] compressor
+ *      A pointer to the compression state of the logger
+ * @param[in] record
+ *      The log message, terminated with a newline
+ * @param[in] length
+ *      The length of the log message in bytes
+ * @param[in] timeStamp
+ *      The local system time the log message was logged at
+ * @param[in] severity
+ *      The log-severity of the log message
+ */
+static void rkCompressorWrite(RKCompressor* compressor, const char* record,
+                              size_t length, const RKTimeStamp* timeStamp,
+                              RKLogSeverity severity)
+{
+    pthread_mutex_lock(&compressor->mutex);
+    for (;;)
+    {
+        rkCompressorWaitFill(compressor);
+        const size_t index = compressor->fillIndex;
+        if (compressor->lengths[index] + length <= RKLOG_COMPRESS_BLOCK_SIZE &&
+            rkIndexFits(&compressor->stats[index], timeStamp))
+            break;
+        rkCompressorQueue(compressor);
+    }
+
+    const size_t index = compressor->fillIndex;
+    const size_t offset = compressor->lengths[index];
+    compressor->lengths[index] += length;
+    compressor->writers[index]++;
+    rkIndexCount(&compressor->stats[index], timeStamp, severity);
+
+    // The first log message of a block starts the clock of the idle thread
+    if (compressor->stats[index].messages == 1)
+        pthread_cond_signal(&compressor->queued);
+    pthread_mutex_unlock(&compressor->mutex);
+
+    // The reserved bytes are ours alone, so copy them without the lock
+    memcpy(compressor->blocks + index * RKLOG_COMPRESS_BLOCK_SIZE + offset,
+           record, length);
+
+    // Only a queued block can be waiting for its last copy to land
+    pthread_mutex_lock(&compressor->mutex);
+    if (--compressor->writers[index] == 0 &&
+        (index != compressor->fillIndex || !compressor->fillReady))
+        pthread_cond_signal(&compressor->queued);
+    pthread_mutex_unlock(&compressor->mutex);
+}
+
+/**
+ * @brief Queues the partially filled block, if any, and waits until the
+ * compression thread has written every queued block
+ *
+ * @param[in] compressor
+ *      A pointer to the compression state of the logger
+ */
+static void rkCompressorFlush(RKCompressor* compressor)
+{
+    pthread_mutex_lock(&compressor->mutex);
+    rkCompressorWaitFill(compressor);
+    if (compressor->lengths[compressor->fillIndex] > 0)
+        rkCompressorQueue(compressor);
+
+    while (compressor->count > 0)
+        pthread_cond_wait(&compressor->done, &compressor->mutex);
+    pthread_mutex_unlock(&compressor->mutex);
+}
+
+/**
+ * @brief Flushes and stops the compression thread, then releases all
+ * compression state
+ *
+ * @param[in] compressor
+ *      A pointer to the compression state of the logger
+ */
+static void rkCompressorClose(RKCompressor* compressor)
+{
+    rkCompressorFlush(compressor);
+
+    pthread_mutex_lock(&compressor->mutex);
+    compressor->stop = true;
+    pthread_cond_signal(&compressor->queued);
+    pthread_mutex_unlock(&compressor->mutex);
+    pthread_join(compressor->thread, NULL);
+
+    pthread_cond_destroy(&compressor->done);
+    pthread_cond_destroy(&compressor->queued);
+    pthread_mutex_destroy(&compressor->mutex);
+    if (compressor->index)
+        fclose(compressor->index);
+    close(compressor->fd);
+    free(compressor->scratch);
+    free(compressor->blocks);
+    free(compressor);
+}
+#endif
+
+/**
+ * @brief Internal implementation of the logging operations. This logs a
+ * formatted message to the output of `logger` using the provided variadic
+ * arguments list
+ *
+ * @param[in] logger
+ *      A pointer to the handle of the logger logging the message
+ * @param[in] severity
+ *      The log-severity of the log message
+ * @param[in] cfg
+ *      The configuration of the log message
+ * @param[in] fmt
+ *      The format specifier of the log message
+ * @param[in] args
+ *      The variadic arguments list
+ */
+static void rkLogInternal(RKLogger* logger, RKLogSeverity severity,
+                          RKLogConfig cfg, const char* fmt, va_list args)
+{
+#define MAX_PRELUDE_SIZE (64)
+#define MAX_LABEL_SIZE (64 + RKLOG_MAX_LOGGER_TITLE_SIZE)
+#define MAX_MESSAGE_SIZE (256)
+#define MAX_RECORD_SIZE (MAX_LABEL_SIZE + MAX_MESSAGE_SIZE + 1)
+
+    char label[MAX_LABEL_SIZE+1] = {0};
+    char message[MAX_MESSAGE_SIZE+1] = {0};
+    
+    const time_t now = time(NULL);
+    const RKTimeStamp timeStamp = rkGetCurrentTime(now);
+    rkGenLabel(label, MAX_LABEL_SIZE, logger->title, cfg.tag, &timeStamp);
+    vsnprintf(message, MAX_MESSAGE_SIZE, fmt, args);
+    
+    switch (logger->sink)
+    {
+        case RKLOG_SINK_CONSOLE:
+        {
+            char prelude[MAX_PRELUDE_SIZE+1] = {0};
+            rkGenColorPrelude(prelude, MAX_PRELUDE_SIZE, cfg);
+
+            fprintf(logger->output, RKLOG_FMT_COLOR_OUTPUT, prelude, label,
+                    message);
+        } break;
+        case RKLOG_SINK_FILE:
+        {
+            rkLockLogger(logger);
+            const int length = fprintf(logger->output, RKLOG_FMT_OUTPUT,
+                                       label, message);
+            if (length > 0)
+                rkIndexRecord(logger, (size_t)length, &timeStamp, severity);
+            rkUnlockLogger(logger);
+        } break;
+        case RKLOG_SINK_URING:
+        {
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+            // Formatted in place, so the record never goes through the stack
+            rkLockLogger(logger);
+            const size_t length = rkUringWrite(logger, label, message);
+            if (length > 0)
+                rkIndexRecord(logger, length, &timeStamp, severity);
+            rkUnlockLogger(logger);
+#endif
+        } break;
+        case RKLOG_SINK_SOCKET:
+        case RKLOG_SINK_COMPRESSED:
+        {
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+            char record[MAX_RECORD_SIZE+1] = {0};
+            const int length = snprintf(record, sizeof(record),
+                                        RKLOG_FMT_OUTPUT, label, message);
+            if (length <= 0)
+                break;
+
+            if (logger->sink == RKLOG_SINK_COMPRESSED)
+            {
+                rkCompressorWrite(logger->compressor, record,
+                                  (size_t)length, &timeStamp, severity);
+                break;
+            }
+
+            rkLockLogger(logger);
+            rkSocketWrite(logger, record, (size_t)length, now, severity);
+            rkUnlockLogger(logger);
+#endif
+        } break;
+    }
+}
+
+// --- rklog implementation ---------------------------------------------------
+
+RKLogger* rkDefaultLogger(const char* title)
+{
+    return rkCreateLogger(title, RKLOG_DEFAULT_LOG_STYLE);
+}
+
+RKLogger* rkDefaultFileLogger(const char* fileName, const char* title)
+{
+    return rkCreateFileLogger(fileName, title, RKLOG_DEFAULT_LOG_STYLE);
+}
+
+RKLogger* rkCreateFileLogger(const char* fileName, const char* title,
+                             RKLogStyle style)
+{
+    return rkPlaceLogger(RKLOG_ORIGIN_HEAP, NULL, 0, fileName, title, style);
+}
+
+RKLogger *rkCreateLogger(const char* title, RKLogStyle style)
+{
+    return rkPlaceLogger(RKLOG_ORIGIN_HEAP, NULL, 0, NULL, title, style);
+}
+
+RKLogger* rkInitLogger(void* storage, size_t size, const char* title,
+                       RKLogStyle style)
+{
+    return rkPlaceLogger(RKLOG_ORIGIN_CALLER, storage, size, NULL, title,
+                         style);
+}
+
+RKLogger* rkInitFileLogger(void* storage, size_t size, const char* fileName,
+                           const char* title, RKLogStyle style)
+{
+    return rkPlaceLogger(RKLOG_ORIGIN_CALLER, storage, size, fileName, title,
+                         style);
+}
+
+RKLoggerPool* rkCreateLoggerPool(size_t capacity, uint32_t buffers)
+{
+    RKLoggerPool* const pool = (RKLoggerPool*)malloc(sizeof(RKLoggerPool));
+    if (!pool) return NULL;
+
+    pool->capacity = capacity;
+    pool->buffers = buffers;
+    pool->socketBuffers = NULL;
+    pool->uringBuffers = NULL;
+    pool->loggers = (RKLogger*)calloc(capacity, sizeof(RKLogger));
+    pool->freeLoggers = (RKLogger**)calloc(capacity, sizeof(RKLogger*));
+    bool ok = capacity == 0 || (pool->loggers && pool->freeLoggers);
+
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+    if (ok && capacity > 0 && (buffers & RKLOG_POOL_SOCKET_BUFFERS))
+    {
+        pool->socketBuffers = capacity <= SIZE_MAX / RKLOG_SOCKET_BUFFER_SIZE
+            ? (char*)malloc(capacity * RKLOG_SOCKET_BUFFER_SIZE)
+            : NULL;
+        ok = pool->socketBuffers != NULL;
+    }
+    if (ok && capacity > 0 && (buffers & RKLOG_POOL_URING_BUFFERS))
+    {
+        const size_t size =
+            (size_t)RKLOG_URING_BUFFER_COUNT * RKLOG_URING_BUFFER_SIZE;
+        pool->uringBuffers = capacity <= SIZE_MAX / size
+            ? (char*)malloc(capacity * size)
+            : NULL;
+        ok = pool->uringBuffers != NULL;
+    }
+#endif
+
+    if (!ok)
+    {
+        free(pool->uringBuffers);
+        free(pool->socketBuffers);
+        free(pool->freeLoggers);
+        free(pool->loggers);
+        free(pool);
+        return NULL;
+    }
+
+    // Hand out the lowest slots first, they are the likeliest to be warm
+    for (size_t i = 0; i < capacity; i++)
+    {
+        const size_t slot = capacity - 1 - i;
+        RKLogger* const logger = &pool->loggers[slot];
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+        logger->pending = pool->socketBuffers
+            ? pool->socketBuffers + slot * RKLOG_SOCKET_BUFFER_SIZE
+            : NULL;
+        logger->buffers = pool->uringBuffers
+            ? pool->uringBuffers + slot * (size_t)RKLOG_URING_BUFFER_COUNT *
+                RKLOG_URING_BUFFER_SIZE
+            : NULL;
+#endif
+        pool->freeLoggers[i] = logger;
+    }
+    pool->freeCount = capacity;
+
+    return pool;
+}
+
+void rkDestroyLoggerPool(RKLoggerPool* pool)
+{
+    free(pool->uringBuffers);
+    free(pool->socketBuffers);
+    free(pool->freeLoggers);
+    free(pool->loggers);
+    free(pool);
+}
+
+RKLogger* rkPoolLogger(RKLoggerPool* pool, const char* title,
+                       RKLogStyle style)
+{
+    return rkPlaceLogger(RKLOG_ORIGIN_POOL, pool, 0, NULL, title, style);
+}
+
+RKLogger* rkPoolFileLogger(RKLoggerPool* pool, const char* fileName,
+                           const char* title, RKLogStyle style)
+{
+    return rkPlaceLogger(RKLOG_ORIGIN_POOL, pool, 0, fileName, title, style);
+}
+
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+/**
+ * @brief Creates a socket logger in memory of the given origin. Pooled loggers
+ * use the message buffer of their pool, others allocate their own
+ *
+ * @param[in] origin
+ *      Where the memory of the logger comes from
+ * @param[in] pool
+ *      The pool to take the logger from, if `origin` is `RKLOG_ORIGIN_POOL`
+ * @param[in] socketPath
+ *      The filesystem path of the socket the agent listens on
+ * @param[in] type
+ *      Whether the agent listens on a datagram or a stream socket
+ * @param[in] title
+ *      The title of the socket logger
+ * @param[in] style
+ *      The styling configuration for the log messages
+ *
+ * @return
+ *      A pointer to the socket logger, or `NULL` upon failure
+ */
+static RKLogger* rkPlaceSocketLogger(RKLoggerOrigin origin, RKLoggerPool* pool,
+                                     const char* socketPath, RKSocketType type,
+                                     const char* title, RKLogStyle style)
+{
+    RKLogger* const logger = rkAcquireLogger(origin, pool, 0);
+    if (!logger) return NULL;
+
+    const size_t pathLength = strlen(socketPath);
+    if (pathLength >= sizeof(logger->socketPath) ||
+        !rkPrepareLogger(logger, RKLOG_SINK_SOCKET, NULL, title, style))
+    {
+        rkRecycleLogger(logger);
+        return NULL;
+    }
+    memcpy(logger->socketPath, socketPath, pathLength + 1);
+    logger->socketType = type;
+
+    // Pooled loggers only ever use the buffers their pool allocated
+    if (!logger->pending && origin != RKLOG_ORIGIN_POOL)
+        logger->pending = (char*)malloc(RKLOG_SOCKET_BUFFER_SIZE);
+    if (!logger->pending)
+    {
+        pthread_mutex_destroy(&logger->lock);
+        rkRecycleLogger(logger);
+        return NULL;
+    }
+
+    // Not being able to reach the agent yet is fine, we retry on send
+    rkSocketConnect(logger);
+    return logger;
+}
+
+/**
+ * @brief Creates a uring file logger in memory of the given origin. Pooled
+ * loggers use the buffers of their pool, others allocate their own
+ *
+ * @param[in] origin
+ *      Where the memory of the logger comes from
+ * @param[in] pool
+ *      The pool to take the logger from, if `origin` is `RKLOG_ORIGIN_POOL`
+ * @param[in] fileName
+ *      The name of the file to log to
+ * @param[in] title
+ *      The title of the file logger
+ * @param[in] style
+ *      The styling configuration for the log messages
+ *
+ * @return
+ *      A pointer to the uring file logger, or `NULL` upon failure
+ */
+static RKLogger* rkPlaceUringFileLogger(RKLoggerOrigin origin,
+                                        RKLoggerPool* pool,
+                                        const char* fileName,
+                                        const char* title, RKLogStyle style)
+{
+    RKLogger* const logger = rkAcquireLogger(origin, pool, 0);
+    if (!logger) return NULL;
+
+    if (!rkPrepareLogger(logger, RKLOG_SINK_URING, NULL, title, style))
+    {
+        rkRecycleLogger(logger);
+        return NULL;
+    }
+
+    if (!logger->buffers && origin != RKLOG_ORIGIN_POOL)
+    {
+        logger->buffers = (char*)malloc(
+            (size_t)RKLOG_URING_BUFFER_COUNT * RKLOG_URING_BUFFER_SIZE
+        );
+    }
+    // The file is only truncated once the logger is sure to get its buffers,
+    // as pools may have been created without any
+    logger->fileFd = logger->buffers
+        ? open(fileName, O_WRONLY | O_CREAT | O_TRUNC, 0666)
+        : -1;
+    if (logger->fileFd < 0)
+    {
+        if (logger->fileFd >= 0) close(logger->fileFd);
+        pthread_mutex_destroy(&logger->lock);
+        rkRecycleLogger(logger);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < RKLOG_URING_BUFFER_COUNT; i++)
+        logger->freeBuffers[logger->freeCount++] = (uint32_t)i;
+
+#if defined(RKLOG_HAS_IO_URING)
+    // Without io_uring every full buffer simply gets written with `write`
+    rkUringSetup(logger);
+#endif
+    return logger;
+}
+
+RKLogger* rkCreateSocketLogger(const char* socketPath, RKSocketType type,
+                               const char* title, RKLogStyle style)
+{
+    return rkPlaceSocketLogger(RKLOG_ORIGIN_HEAP, NULL, socketPath, type,
+                               title, style);
+}
+
+RKLogger* rkCreateUringFileLogger(const char* fileName, const char* title,
+                                  RKLogStyle style)
+{
+    return rkPlaceUringFileLogger(RKLOG_ORIGIN_HEAP, NULL, fileName, title,
+                                  style);
+}
+
+RKLogger* rkPoolSocketLogger(RKLoggerPool* pool, const char* socketPath,
+                             RKSocketType type, const char* title,
+                             RKLogStyle style)
+{
+    return rkPlaceSocketLogger(RKLOG_ORIGIN_POOL, pool, socketPath, type,
+                               title, style);
+}
+
+RKLogger* rkPoolUringFileLogger(RKLoggerPool* pool, const char* fileName,
+                                const char* title, RKLogStyle style)
+{
+    return rkPlaceUringFileLogger(RKLOG_ORIGIN_POOL, pool, fileName, title,
+                                  style);
+}
+
+RKLogger* rkCreateCompressedFileLogger(const char* fileName, const char* title,
+                                       RKLogStyle style)
+{
+    RKCompressor* const compressor =
+        (RKCompressor*)calloc(1, sizeof(RKCompressor));
+    if (!compressor) return NULL;
+
+    compressor->blocks = (char*)malloc(
+        (size_t)RKLOG_COMPRESS_BLOCK_COUNT * RKLOG_COMPRESS_BLOCK_SIZE
+    );
+    compressor->scratch = (char*)malloc(
+        RKLOG_COMPRESS_HEADER_SIZE +
+        RKLOG_COMPRESS_BOUND(RKLOG_COMPRESS_BLOCK_SIZE)
+    );
+    compressor->fd = open(fileName, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+
+    RKLogger* const logger = compressor->blocks && compressor->scratch &&
+        compressor->fd >= 0
+        ? rkNewLogger(RKLOG_SINK_COMPRESSED, NULL, title, style)
+        : NULL;
+    if (!logger)
+    {
+        if (compressor->fd >= 0) close(compressor->fd);
+        free(compressor->scratch);
+        free(compressor->blocks);
+        free(compressor);
+        return NULL;
+    }
+
+    compressor->fillReady = true;
+    pthread_mutex_init(&compressor->mutex, NULL);
+    pthread_cond_init(&compressor->queued, NULL);
+    pthread_cond_init(&compressor->done, NULL);
+    if (pthread_create(&compressor->thread, NULL, rkCompressorMain,
+                       compressor) != 0)
+    {
+        pthread_cond_destroy(&compressor->done);
+        pthread_cond_destroy(&compressor->queued);
+        pthread_mutex_destroy(&compressor->mutex);
+        close(compressor->fd);
+        free(compressor->scratch);
+        free(compressor->blocks);
+        free(compressor);
+        pthread_mutex_destroy(&logger->lock);
+        free(logger);
+        return NULL;
+    }
+
+    logger->compressor = compressor;
+    return logger;
+}
+#endif
+
+bool rkDecompressLogFile(FILE* in, FILE* out)
+{
+    unsigned char header[RKLOG_COMPRESS_HEADER_SIZE];
+    unsigned char* const payload = (unsigned char*)malloc(
+        RKLOG_COMPRESS_BOUND(RKLOG_COMPRESS_BLOCK_SIZE)
     );
+    unsigned char* const raw = (unsigned char*)malloc(
+        RKLOG_COMPRESS_BLOCK_SIZE
+    );
+
+    bool ok = payload && raw;
+    while (ok)
+    {
+        const size_t got = fread(header, 1, sizeof(header), in);
+        if (got == 0 && feof(in))
+            break;
+
+        const size_t stored = got == sizeof(header)
+            ? rkLoadU32(header + 8)
+            : SIZE_MAX;
+        if (stored > RKLOG_COMPRESS_BOUND(RKLOG_COMPRESS_BLOCK_SIZE) ||
+            memcmp(header, RKLOG_COMPRESS_MAGIC, 4) != 0 ||
+            fread(payload, 1, stored, in) != stored)
+        {
+            ok = false;
+            break;
+        }
+
+        const size_t length = rkDecodeBlock(header, payload, raw);
+        ok = length != SIZE_MAX && fwrite(raw, 1, length, out) == length;
+    }
+
+    free(raw);
+    free(payload);
+    return ok;
+}
+
+/**
+ * @brief Gets the length of a string, looking at no more than `max` characters
+ *
+ * @param[in] str
+ *      The string to measure
+ * @param[in] max
+ *      The maximum length to report
+ *
+ * @return
+ *      The length of `str`, or `max` if it is longer
+ */
+static size_t rkBoundedLength(const char* str, size_t max)
+{
+    const char* const end = (const char*)memchr(str, '\0', max);
+    return end ? (size_t)(end - str) : max;
+}
+
+bool rkEnableLogIndex(RKLogger* logger, const char* indexFileName)
+{
+    const bool compressed = logger->sink == RKLOG_SINK_COMPRESSED;
+    if (logger->index || (logger->sink != RKLOG_SINK_FILE &&
+                          logger->sink != RKLOG_SINK_URING && !compressed))
+        return false;
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+    if (compressed && logger->compressor->index)
+        return false;
+#endif
+
+#if defined(RKLOG_PLATFORM_WINDOWS)
+    FILE* index = NULL;
+    if (fopen_s(&index, indexFileName, "wb") != 0)
+        return false;
+#else
+    FILE* index = fopen(indexFileName, "wb");
+    if (!index) return false;
+#endif
+
+    // The header carries the title and tags so that readers can tell the
+    // log-severity and time of individual log messages
+    unsigned char header[RKLOG_INDEX_HEADER_SIZE] = {0};
+    const RKLogConfig* const configs[] = {
+        &logger->style.cfgInfo,
+        &logger->style.cfgWarning,
+        &logger->style.cfgError,
+        &logger->style.cfgFatalError,
+    };
+
+    memcpy(header, RKLOG_INDEX_MAGIC, 4);
+    rkStoreU32(header + 4, RKLOG_INDEX_VERSION);
+    rkStoreU32(header + 8, compressed ? 1 : 0);
+    memcpy(header + 16, logger->title,
+           rkBoundedLength(logger->title, RKLOG_MAX_LOGGER_TITLE_SIZE));
+    for (size_t i = 0; i < 4; i++)
+    {
+        memcpy(header + 96 + i * RKLOG_INDEX_TAG_SIZE, configs[i]->tag,
+               rkBoundedLength(configs[i]->tag, RKLOG_INDEX_TAG_SIZE - 1));
+    }
+
+    if (fwrite(header, 1, sizeof(header), index) != sizeof(header))
+    {
+        fclose(index);
+        return false;
+    }
+
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+    if (compressed)
+    {
+        pthread_mutex_lock(&logger->compressor->mutex);
+        logger->compressor->index = index;
+        pthread_mutex_unlock(&logger->compressor->mutex);
+        return true;
+    }
+#endif
+
+    rkLockLogger(logger);
+    logger->index = index;
+    rkUnlockLogger(logger);
+    return true;
+}
+
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+/**
+ * Struct definition for a log reader
+ */
+struct RKLogReader
+{
+    /* The mapped log file, or `NULL` if it is empty */
+    const unsigned char* log;
+    /* The size of the log file in bytes */
+    size_t logSize;
+    /* The mapped index file */
+    const unsigned char* index;
+    /* The size of the index file in bytes */
+    size_t indexSize;
+    /* Flag indicating whether the log file is block compressed */
+    bool compressed;
+    /* Decompression buffer for blocks of compressed log files */
+    unsigned char* scratch;
+    /* The `[title]:[` part every log message starts with */
+    char prefix[RKLOG_MAX_LOGGER_TITLE_SIZE + 8];
+    /* The tags of the info, warning, error and fatal log messages */
+    char tags[4][RKLOG_INDEX_TAG_SIZE];
+};
+
+/**
+ * @brief Maps a whole file read-only into memory
+ *
+ * @param[in] fileName
+ *      The name of the file to map
+ * @param[out] size
+ *      The size of the file in bytes
+ * @param[out] data
+ *      The mapping, or `NULL` if the file is empty
+ *
+ * @return
+ *      `true` on success, `false` otherwise
+ */
+static bool rkMapFile(const char* fileName, size_t* size,
+                      const unsigned char** data)
+{
+    const int fd = open(fileName, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    *size = (size_t)info.st_size;
+    *data = NULL;
+    if (*size > 0)
+    {
+        void* const mapping = mmap(NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED)
+        {
+            close(fd);
+            return false;
+        }
+        *data = (const unsigned char*)mapping;
+    }
+
+    close(fd);
+    return true;
+}
+
+/**
+ * @brief Parses the `HH:MM:SS` time of day of a label. Unlike `sscanf`, this
+ * never looks past the 8 characters of the time
+ *
+ * @param[in] text
+ *      The start of the time of day, at least 8 readable characters
+ *
+ * @return
+ *      The number of seconds since midnight, or `-1` if `text` is no time
+ */
+static int64_t rkParseClock(const char* text)
+{
+    int64_t seconds = 0;
+    for (size_t i = 0; i < 8; i += 3)
+    {
+        if (text[i] < '0' || text[i] > '9' ||
+            text[i + 1] < '0' || text[i + 1] > '9' ||
+            (i < 6 && text[i + 2] != ':'))
+            return -1;
+
+        seconds = seconds * 60 + (text[i] - '0') * 10 + (text[i + 1] - '0');
+    }
+
+    return seconds;
+}
+
+RKLogReader* rkOpenLogReader(const char* fileName, const char* indexFileName)
+{
+    RKLogReader* const reader = (RKLogReader*)calloc(1, sizeof(RKLogReader));
+    if (!reader) return NULL;
+
+    if (!rkMapFile(indexFileName, &reader->indexSize, &reader->index))
+    {
+        free(reader);
+        return NULL;
+    }
+    if (reader->indexSize < RKLOG_INDEX_HEADER_SIZE ||
+        memcmp(reader->index, RKLOG_INDEX_MAGIC, 4) != 0 ||
+        rkLoadU32(reader->index + 4) != RKLOG_INDEX_VERSION ||
+        !rkMapFile(fileName, &reader->logSize, &reader->log))
+    {
+        if (reader->index)
+            munmap((void*)reader->index, reader->indexSize);
+        free(reader);
+        return NULL;
+    }
+
+    reader->compressed = rkLoadU32(reader->index + 8) == 1;
+    if (reader->compressed)
+    {
+        reader->scratch = (unsigned char*)malloc(RKLOG_COMPRESS_BLOCK_SIZE);
+        if (!reader->scratch)
+        {
+            rkCloseLogReader(reader);
+            return NULL;
+        }
+    }
+
+    char title[RKLOG_MAX_LOGGER_TITLE_SIZE + 1] = {0};
+    memcpy(title, reader->index + 16, RKLOG_MAX_LOGGER_TITLE_SIZE);
+    snprintf(reader->prefix, sizeof(reader->prefix), "[%s]:[", title);
+    for (size_t i = 0; i < 4; i++)
+    {
+        memcpy(reader->tags[i], reader->index + 96 + i * RKLOG_INDEX_TAG_SIZE,
+               RKLOG_INDEX_TAG_SIZE - 1);
+    }
+
+    return reader;
+}
+
+size_t rkQueryLog(RKLogReader* reader, int64_t from, int64_t to,
+                  uint32_t severities, RKLogVisitor visitor, void* userData)
+{
+    const size_t prefixLength = strlen(reader->prefix);
+    const size_t entries = (reader->indexSize - RKLOG_INDEX_HEADER_SIZE) /
+        RKLOG_INDEX_ENTRY_SIZE;
+    size_t matches = 0;
+
+    for (size_t i = 0; i < entries; i++)
+    {
+        const RKIndexEntry entry = rkIndexParse(
+            reader->index + RKLOG_INDEX_HEADER_SIZE +
+            i * RKLOG_INDEX_ENTRY_SIZE
+        );
+        if (entry.lastTime < from || entry.firstTime > to ||
+            !(entry.severities & severities))
+            continue;
+
+        // The index may run ahead of a log file that was not flushed yet
+        if (entry.offset >= reader->logSize)
+            break;
+        size_t length = (size_t)entry.length;
+        if (length > reader->logSize - entry.offset)
+            length = reader->logSize - (size_t)entry.offset;
+
+        const char* block = (const char*)reader->log + entry.offset;
+        if (reader->compressed)
+        {
+            const unsigned char* const header = reader->log + entry.offset;
+            if (length < RKLOG_COMPRESS_HEADER_SIZE ||
+                memcmp(header, RKLOG_COMPRESS_MAGIC, 4) != 0 ||
+                rkLoadU32(header + 8) > length - RKLOG_COMPRESS_HEADER_SIZE)
+                continue;
+
+            length = rkDecodeBlock(header, header + RKLOG_COMPRESS_HEADER_SIZE,
+                                   reader->scratch);
+            if (length == SIZE_MAX)
+                continue;
+            block = (const char*)reader->scratch;
+        }
+
+        // Lines without a label continue the log message before them, so a
+        // log message runs from its labeled line up to the next one. Labels
+        // only carry the time of day, which is resolved against the start of
+        // the writer's local day recorded with the block; writers end a block
+        // whenever their local day or UTC offset changes
+        const char* message = NULL;
+        const char* messageEnd = NULL;
+        RKLogSeverity severity = RKLOG_SEVERITY_INFO;
+        int64_t timestamp = 0;
+
+        const char* const end = block + length;
+        for (const char* line = block;;)
+        {
+            const char* eol = end;
+            bool labeled = false;
+            RKLogSeverity lineSeverity = RKLOG_SEVERITY_INFO;
+            int64_t lineTimestamp = 0;
+
+            if (line < end)
+            {
+                eol = (const char*)memchr(line, '\n', (size_t)(end - line));
+                if (!eol) eol = end;
+                const char* const tag = line + prefixLength;
+                const bool prefixed = (size_t)(eol - line) > prefixLength &&
+                    memcmp(line, reader->prefix, prefixLength) == 0;
+                for (size_t t = 0; prefixed && t < 4; t++)
+                {
+                    const size_t tagLength = strlen(reader->tags[t]);
+                    if (tagLength + 11 > (size_t)(eol - tag) ||
+                        memcmp(tag, reader->tags[t], tagLength) != 0 ||
+                        memcmp(tag + tagLength, "]:[", 3) != 0)
+                        continue;
+
+                    const int64_t clock = rkParseClock(tag + tagLength + 3);
+                    if (clock < 0)
+                        continue;
+
+                    labeled = true;
+                    lineSeverity = (RKLogSeverity)(1u << t);
+                    lineTimestamp = entry.dayStart + clock;
+                    break;
+                }
+            }
+
+            // A label or the end of the block completes the pending message
+            if (message && (labeled || line >= end))
+            {
+                matches++;
+                if (!visitor(message, (size_t)(messageEnd - message),
+                             severity, timestamp, userData))
+                    return matches;
+                message = NULL;
+            }
+            if (line >= end)
+                break;
+
+            if (labeled && (severities & (uint32_t)lineSeverity) &&
+                lineTimestamp >= from && lineTimestamp <= to)
+            {
+                message = line;
+                severity = lineSeverity;
+                timestamp = lineTimestamp;
+            }
+            if (message)
+                messageEnd = eol;
+            line = eol + 1;
+        }
+    }
+
+    return matches;
+}
+
+void rkCloseLogReader(RKLogReader* reader)
+{
+    if (reader->log)
+        munmap((void*)reader->log, reader->logSize);
+    if (reader->index)
+        munmap((void*)reader->index, reader->indexSize);
+    free(reader->scratch);
+    free(reader);
+}
+#endif
+
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+size_t rkGetDroppedMessages(RKLogger* logger)
+{
+    if (logger->sink != RKLOG_SINK_SOCKET)
+        return 0;
+
+    rkLockLogger(logger);
+    const size_t dropped = logger->droppedMessages;
+    rkUnlockLogger(logger);
+
+    return dropped;
+}
+#endif
+
+void rkFlushLogger(RKLogger* logger)
+{
+    switch (logger->sink)
+    {
+        case RKLOG_SINK_CONSOLE:
+        case RKLOG_SINK_FILE:
+        {
+            rkLockLogger(logger);
+            fflush(logger->output);
+            rkIndexFlush(logger);
+            rkUnlockLogger(logger);
+        } break;
+        case RKLOG_SINK_SOCKET:
+        {
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+            rkLockLogger(logger);
+            rkSocketSend(logger);
+            rkUnlockLogger(logger);
+#endif
+        } break;
+        case RKLOG_SINK_URING:
+        {
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+            rkLockLogger(logger);
+            rkUringFlush(logger);
+            rkIndexFlush(logger);
+            rkUnlockLogger(logger);
+#endif
+        } break;
+        case RKLOG_SINK_COMPRESSED:
+        {
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+            rkCompressorFlush(logger->compressor);
+            if (logger->compressor->index)
+                fflush(logger->compressor->index);
+#endif
+        } break;
+    }
+}
+
+void rkCloseLogger(RKLogger* logger)
+{
+    switch (logger->sink)
+    {
+        case RKLOG_SINK_CONSOLE:
+            break;
+        case RKLOG_SINK_FILE:
+        {
+            fclose(logger->output);
+            rkIndexFlush(logger);
+        } break;
+        case RKLOG_SINK_SOCKET:
+        {
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+            rkSocketSend(logger);
+            rkSocketDisconnect(logger);
+#endif
+        } break;
+        case RKLOG_SINK_URING:
+        {
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+            rkUringFlush(logger);
+            rkIndexFlush(logger);
+#if defined(RKLOG_HAS_IO_URING)
+            rkUringTeardown(logger);
+#endif
+            close(logger->fileFd);
+#endif
+        } break;
+        case RKLOG_SINK_COMPRESSED:
+        {
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+            rkCompressorClose(logger->compressor);
+#endif
+        } break;
+    }
+
+    if (logger->index)
+        fclose(logger->index);
+#if !defined(RKLOG_PLATFORM_WINDOWS)
+    pthread_mutex_destroy(&logger->lock);
+#endif
+    rkRecycleLogger(logger);
+}
+
+void rkLogInfo(RKLogger* logger, const char* fmt, ...)
+{
+    va_list args = {0};
+
+    va_start(args, fmt);
+    rkLogInfoArgs(logger, fmt, args);
+    va_end(args);
+}
+
+void rkLogWarning(RKLogger* logger, const char* fmt, ...)
+{
+    va_list args = {0};
+
+    va_start(args, fmt);
+    rkLogWarningArgs(logger, fmt, args);
+    va_end(args);
+}
+
+void rkLogError(RKLogger* logger, const char* fmt, ...)
+{
+    va_list args = {0};
+
+    va_start(args, fmt);
+    rkLogErrorArgs(logger, fmt, args);
+    va_end(args);
+}
+
+void rkLogFatal(RKLogger* logger, const char* fmt, ...)
+{
+    va_list args = {0};
+
+    va_start(args, fmt);
+    rkLogFatalArgs(logger, fmt, args);
+    va_end(args);
+}
+
+void rkLogInfoArgs(RKLogger* logger, const char* fmt, va_list args)
+{
+    rkLogInternal(logger, RKLOG_SEVERITY_INFO, logger->style.cfgInfo, fmt,
+                  args);
+}
+
+void rkLogWarningArgs(RKLogger* logger, const char* fmt, va_list args)
+{
+    rkLogInternal(logger, RKLOG_SEVERITY_WARNING, logger->style.cfgWarning, fmt,
+                  args);
+}
+
+void rkLogErrorArgs(RKLogger* logger, const char* fmt, va_list args)
+{
+    rkLogInternal(logger, RKLOG_SEVERITY_ERROR, logger->style.cfgError, fmt,
+                  args);
+}
+
+void rkLogFatalArgs(RKLogger* logger, const char* fmt, va_list args)
+{
+    rkLogInternal(logger, RKLOG_SEVERITY_FATAL, logger->style.cfgFatalError, fmt,
+                  args);
 }
 
 #endif /* RKLOG_IMPLEMENTATION */
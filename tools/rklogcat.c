@@ -0,0 +1,34 @@
+#define RKLOG_IMPLEMENTATION
+#include <rklog/rklog.h>
+
+/**
+ * rklogcat: writes the plain log messages of compressed rklog files to
+ * `stdout`. Reads `stdin` when no files are given
+ */
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+        return rkDecompressLogFile(stdin, stdout) ? 0 : 1;
+
+    int status = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        FILE* in = fopen(argv[i], "rb");
+        if (!in)
+        {
+            fprintf(stderr, "rklogcat: cannot open %s\n", argv[i]);
+            status = 1;
+            continue;
+        }
+
+        if (!rkDecompressLogFile(in, stdout))
+        {
+            fprintf(stderr, "rklogcat: %s: truncated or damaged block\n",
+                    argv[i]);
+            status = 1;
+        }
+        fclose(in);
+    }
+
+    return status;
+}
@@ -0,0 +1,143 @@
+#define RKLOG_IMPLEMENTATION
+#include <rklog/rklog.h>
+
+/**
+ * rklogquery: prints the log messages of an indexed rklog file that fall in a
+ * time range and have one of the requested log-severities, using the index to
+ * skip every block that cannot match
+ */
+
+static void usage(void)
+{
+    fprintf(stderr,
+        "usage: rklogquery [-from TIME] [-to TIME] [-severity LIST] "
+        "LOGFILE INDEXFILE\n"
+        "  TIME is seconds since the epoch or 'YYYY-MM-DDTHH:MM:SS' in the\n"
+        "  time zone of this machine, whatever zone the log was written in\n"
+        "  LIST is a comma separated list of info, warning, error, fatal\n");
+}
+
+/**
+ * @brief Parses a point in time given on the command line
+ *
+ * @param[in] text
+ *      The text to parse
+ * @param[out] time
+ *      The parsed point in time, in seconds since the epoch
+ *
+ * @return
+ *      `true` on success, `false` otherwise
+ */
+static bool parseTime(const char* text, int64_t* time)
+{
+    char* end = NULL;
+    const long long seconds = strtoll(text, &end, 10);
+    if (end != text && *end == '\0')
+    {
+        *time = (int64_t)seconds;
+        return true;
+    }
+
+    struct tm local;
+    memset(&local, 0, sizeof(local));
+    if (sscanf(text, "%d-%d-%dT%d:%d:%d", &local.tm_year, &local.tm_mon,
+               &local.tm_mday, &local.tm_hour, &local.tm_min,
+               &local.tm_sec) != 6)
+        return false;
+
+    local.tm_year -= 1900;
+    local.tm_mon -= 1;
+    local.tm_isdst = -1;
+    *time = (int64_t)mktime(&local);
+    return true;
+}
+
+/**
+ * @brief Parses a comma separated list of log-severities
+ *
+ * @param[in] text
+ *      The text to parse
+ * @param[out] severities
+ *      The mask of `RKLogSeverity` flags in the list
+ *
+ * @return
+ *      `true` on success, `false` otherwise
+ */
+static bool parseSeverities(const char* text, uint32_t* severities)
+{
+    static const char* const NAMES[] = { "info", "warning", "error", "fatal" };
+
+    *severities = 0;
+    while (*text)
+    {
+        const size_t length = strcspn(text, ",");
+        size_t i = 0;
+        while (i < 4 && (strlen(NAMES[i]) != length ||
+                         strncmp(NAMES[i], text, length) != 0))
+            i++;
+        if (i == 4)
+            return false;
+
+        *severities |= 1u << i;
+        text += length;
+        if (*text == ',')
+            text++;
+    }
+
+    return *severities != 0;
+}
+
+static bool printMessage(const char* line, size_t length,
+                         RKLogSeverity severity, int64_t timestamp,
+                         void* userData)
+{
+    (void)severity;
+    (void)timestamp;
+    (void)userData;
+
+    fwrite(line, 1, length, stdout);
+    fputc('\n', stdout);
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    int64_t from = INT64_MIN;
+    int64_t to = INT64_MAX;
+    uint32_t severities = RKLOG_SEVERITY_ALL;
+
+    int i = 1;
+    for (; i + 1 < argc && argv[i][0] == '-'; i += 2)
+    {
+        bool ok = false;
+        if (strcmp(argv[i], "-from") == 0)
+            ok = parseTime(argv[i + 1], &from);
+        else if (strcmp(argv[i], "-to") == 0)
+            ok = parseTime(argv[i + 1], &to);
+        else if (strcmp(argv[i], "-severity") == 0)
+            ok = parseSeverities(argv[i + 1], &severities);
+
+        if (!ok)
+        {
+            usage();
+            return 1;
+        }
+    }
+
+    if (argc - i != 2)
+    {
+        usage();
+        return 1;
+    }
+
+    RKLogReader* reader = rkOpenLogReader(argv[i], argv[i + 1]);
+    if (!reader)
+    {
+        fprintf(stderr, "rklogquery: cannot open %s with index %s\n",
+                argv[i], argv[i + 1]);
+        return 1;
+    }
+
+    rkQueryLog(reader, from, to, severities, printMessage, NULL);
+    rkCloseLogReader(reader);
+}